@@ -0,0 +1,567 @@
+/*
+ *  ArrayList.h
+ *  Name: Leo Kim
+ *  Date: 10/19/2026
+ *
+ *  Purpose: Declaration and definition of the ArrayList class template,
+ *           the same array list as CharArrayList for any element type T.
+ *           Storage comes from an Allocator (std::allocator by default).
+ *           For trivially copyable T, growing, copying and shifting
+ *           elements are single memcpy/memmove calls; other types are
+ *           moved one element at a time. Being a template, everything is
+ *           defined in this header.
+ *
+ */
+#ifndef ARRAY_LIST_H
+#define ARRAY_LIST_H
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+template <typename T, typename Allocator = std::allocator<T>>
+class ArrayList {
+public:
+    ArrayList();    // Default Constructor
+    ArrayList(T value);     // Constructor with one initial element
+    ArrayList(const T arr[], int size);     // Constructor with initial arr
+    ArrayList(const ArrayList &other);      // Copy Constructor
+    ArrayList(ArrayList &&other) noexcept;  // Move Constructor
+    ~ArrayList();   // Destructor
+    ArrayList &operator=(const ArrayList &other);
+    ArrayList &operator=(ArrayList &&other) noexcept;
+
+    bool isEmpty() const;
+    void clear();
+    int size() const;
+    const T &first() const;
+    const T &last() const;
+    const T &elementAt(int index) const;
+    const T &operator[](int index) const;
+    void pushAtBack(T value);
+    void pushAtFront(T value);
+    void insertAt(T value, int index);
+    void popFromFront();
+    void popFromBack();
+    void removeAt(int index);
+    void replaceAt(T value, int index);
+    void concatenate(const ArrayList *other);
+    void shrink();
+
+    // the memmove shifts behind insertAt and removeAt for trivially
+    // copyable T, also used by CharArrayList on its own storage
+    static void openGap(T *elements, int size, int index);
+    static void closeGap(T *elements, int size, int index);
+
+private:
+    using Traits = std::allocator_traits<Allocator>;
+    static constexpr bool TRIVIAL = std::is_trivially_copyable_v<T>;
+
+    int numItems;
+    int capacity;
+    T *data;
+    [[no_unique_address]] Allocator allocator;
+
+    // helper functions
+    void resize(int newCapacity);
+    void reserveFor(int extra);
+    void destroyAll();
+    void checkIndex(int index) const;
+};
+
+/*
+ * name:      ArrayList default constructor
+ * purpose:   initialize an empty ArrayList
+ * arguments: none
+ * returns:   none
+ * effects:   numItems and capacity to 0, no array
+ */
+template <typename T, typename Allocator>
+ArrayList<T, Allocator>::ArrayList() {
+    numItems = 0;
+    capacity = 0;
+    data = nullptr;
+}
+
+/*
+ * name:      ArrayList single element constructor
+ * purpose:   initialize an ArrayList with one element
+ * arguments: the element
+ * returns:   none
+ * effects:   numItems to 1
+ */
+template <typename T, typename Allocator>
+ArrayList<T, Allocator>::ArrayList(T value) : ArrayList() {
+    pushAtBack(std::move(value));
+}
+
+/*
+ * name:      ArrayList array constructor
+ * purpose:   initialize an ArrayList with a copy of an array
+ * arguments: the array and its size
+ * returns:   none
+ * effects:   numItems to size, with capacity exactly size
+ */
+template <typename T, typename Allocator>
+ArrayList<T, Allocator>::ArrayList(const T arr[], int size) : ArrayList() {
+    resize(size);
+    if constexpr (TRIVIAL) {
+        if (size > 0) {
+            std::memcpy(data, arr, size * sizeof(T));
+        }
+        numItems = size;
+    } else {
+        for (; numItems < size; numItems++) {
+            Traits::construct(allocator, data + numItems, arr[numItems]);
+        }
+    }
+}
+
+/*
+ * name:      ArrayList copy constructor
+ * purpose:   makes a deep copy of another ArrayList
+ * arguments: the other ArrayList
+ * returns:   none
+ * effects:   capacity is exactly the other list's size
+ */
+template <typename T, typename Allocator>
+ArrayList<T, Allocator>::ArrayList(const ArrayList &other)
+    : ArrayList(other.data, other.numItems) {
+}
+
+/*
+ * name:      ArrayList move constructor
+ * purpose:   takes over the array of an ArrayList that is about to go away
+ * arguments: the other ArrayList
+ * returns:   none
+ * effects:   leaves the other list empty
+ */
+template <typename T, typename Allocator>
+ArrayList<T, Allocator>::ArrayList(ArrayList &&other) noexcept
+    : allocator(std::move(other.allocator)) {
+    numItems = other.numItems;
+    capacity = other.capacity;
+    data = other.data;
+    other.numItems = 0;
+    other.capacity = 0;
+    other.data = nullptr;
+}
+
+/*
+ * name:      ArrayList destructor
+ * purpose:   destroys the elements and frees the array
+ * arguments: none
+ * returns:   none
+ * effects:   none
+ */
+template <typename T, typename Allocator>
+ArrayList<T, Allocator>::~ArrayList() {
+    destroyAll();
+}
+
+/*
+ * name:      assignment operator
+ * purpose:   makes this ArrayList a deep copy of another
+ * arguments: the other ArrayList
+ * returns:   this ArrayList
+ * effects:   frees the old array
+ */
+template <typename T, typename Allocator>
+ArrayList<T, Allocator> &ArrayList<T, Allocator>::operator=(
+    const ArrayList &other) {
+    if (this != &other) {
+        ArrayList copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+/*
+ * name:      move assignment operator
+ * purpose:   takes over the array of an ArrayList that is about to go away
+ * arguments: the other ArrayList
+ * returns:   this ArrayList
+ * effects:   frees the old array and leaves the other list empty
+ */
+template <typename T, typename Allocator>
+ArrayList<T, Allocator> &ArrayList<T, Allocator>::operator=(
+    ArrayList &&other) noexcept {
+    if (this != &other) {
+        destroyAll();
+        allocator = std::move(other.allocator);
+        numItems = other.numItems;
+        capacity = other.capacity;
+        data = other.data;
+        other.numItems = 0;
+        other.capacity = 0;
+        other.data = nullptr;
+    }
+    return *this;
+}
+
+/*
+ * name:      isEmpty
+ * purpose:   determines if the ArrayList is empty
+ * arguments: none
+ * returns:   true if it has no elements
+ * effects:   none
+ */
+template <typename T, typename Allocator>
+bool ArrayList<T, Allocator>::isEmpty() const {
+    return numItems == 0;
+}
+
+/*
+ * name:      clear
+ * purpose:   removes every element
+ * arguments: none
+ * returns:   none
+ * effects:   frees the array
+ */
+template <typename T, typename Allocator>
+void ArrayList<T, Allocator>::clear() {
+    destroyAll();
+    numItems = 0;
+    capacity = 0;
+    data = nullptr;
+}
+
+/*
+ * name:      size
+ * purpose:   determines the number of elements
+ * arguments: none
+ * returns:   the number of elements
+ * effects:   none
+ */
+template <typename T, typename Allocator>
+int ArrayList<T, Allocator>::size() const {
+    return numItems;
+}
+
+/*
+ * name:      first
+ * purpose:   gets the first element
+ * arguments: none
+ * returns:   the first element, or an error if the list is empty
+ * effects:   none
+ */
+template <typename T, typename Allocator>
+const T &ArrayList<T, Allocator>::first() const {
+    if (isEmpty()) {
+        throw std::runtime_error("cannot get first of empty ArrayList");
+    }
+    return data[0];
+}
+
+/*
+ * name:      last
+ * purpose:   gets the last element
+ * arguments: none
+ * returns:   the last element, or an error if the list is empty
+ * effects:   none
+ */
+template <typename T, typename Allocator>
+const T &ArrayList<T, Allocator>::last() const {
+    if (isEmpty()) {
+        throw std::runtime_error("cannot get last of empty ArrayList");
+    }
+    return data[numItems - 1];
+}
+
+/*
+ * name:      elementAt
+ * purpose:   gets the element at an index
+ * arguments: the index
+ * returns:   the element, or an error if the index is out of range
+ * effects:   none
+ */
+template <typename T, typename Allocator>
+const T &ArrayList<T, Allocator>::elementAt(int index) const {
+    checkIndex(index);
+    return data[index];
+}
+
+/*
+ * name:      operator[]
+ * purpose:   gets the element at an index without checking the index
+ * arguments: the index, which must be in range [0..size())
+ * returns:   the element
+ * effects:   none
+ */
+template <typename T, typename Allocator>
+const T &ArrayList<T, Allocator>::operator[](int index) const {
+    return data[index];
+}
+
+/*
+ * name:      pushAtBack
+ * purpose:   adds an element to the back
+ * arguments: the element
+ * returns:   none
+ * effects:   grows the array if it is full
+ */
+template <typename T, typename Allocator>
+void ArrayList<T, Allocator>::pushAtBack(T value) {
+    reserveFor(1);
+    Traits::construct(allocator, data + numItems, std::move(value));
+    numItems++;
+}
+
+/*
+ * name:      pushAtFront
+ * purpose:   adds an element to the front
+ * arguments: the element
+ * returns:   none
+ * effects:   moves every element back one place
+ */
+template <typename T, typename Allocator>
+void ArrayList<T, Allocator>::pushAtFront(T value) {
+    insertAt(std::move(value), 0);
+}
+
+/*
+ * name:      insertAt
+ * purpose:   adds an element at an index
+ * arguments: the element and the index, in range [0..size()]
+ * returns:   error message if the index is out of range
+ * effects:   moves the elements from the index on back one place
+ */
+template <typename T, typename Allocator>
+void ArrayList<T, Allocator>::insertAt(T value, int index) {
+    if (index > numItems or index < 0) {
+        throw std::range_error( "index (" + std::to_string(index) +
+        ") not in range [0.." + std::to_string(numItems) + "]" );
+    }
+    reserveFor(1);
+    if constexpr (TRIVIAL) {
+        openGap(data, numItems, index);
+        std::memcpy(data + index, &value, sizeof(T));
+    } else if (index == numItems) {
+        Traits::construct(allocator, data + numItems, std::move(value));
+    } else {
+        Traits::construct(allocator, data + numItems,
+                          std::move(data[numItems - 1]));
+        std::move_backward(data + index, data + numItems - 1,
+                           data + numItems);
+        data[index] = std::move(value);
+    }
+    numItems++;
+}
+
+/*
+ * name:      popFromFront
+ * purpose:   removes the first element
+ * arguments: none
+ * returns:   error message if the list is empty
+ * effects:   moves every other element forward one place
+ */
+template <typename T, typename Allocator>
+void ArrayList<T, Allocator>::popFromFront() {
+    if (isEmpty()) {
+        throw std::runtime_error("cannot pop from empty ArrayList");
+    }
+    removeAt(0);
+}
+
+/*
+ * name:      popFromBack
+ * purpose:   removes the last element
+ * arguments: none
+ * returns:   error message if the list is empty
+ * effects:   none
+ */
+template <typename T, typename Allocator>
+void ArrayList<T, Allocator>::popFromBack() {
+    if (isEmpty()) {
+        throw std::runtime_error("cannot pop from empty ArrayList");
+    }
+    numItems--;
+    Traits::destroy(allocator, data + numItems);
+}
+
+/*
+ * name:      removeAt
+ * purpose:   removes the element at an index
+ * arguments: the index
+ * returns:   error message if the index is out of range
+ * effects:   moves the elements after it forward one place
+ */
+template <typename T, typename Allocator>
+void ArrayList<T, Allocator>::removeAt(int index) {
+    checkIndex(index);
+    if constexpr (TRIVIAL) {
+        closeGap(data, numItems, index);
+    } else {
+        std::move(data + index + 1, data + numItems, data + index);
+        Traits::destroy(allocator, data + numItems - 1);
+    }
+    numItems--;
+}
+
+/*
+ * name:      openGap
+ * purpose:   makes room for one element at an index
+ * arguments: the elements, how many are in use, and the index, in range
+ *            [0..size]; there must be room for size + 1 elements
+ * returns:   none
+ * effects:   moves the elements from the index on back one place, leaving
+ *            the element at the index to be overwritten
+ */
+template <typename T, typename Allocator>
+void ArrayList<T, Allocator>::openGap(T *elements, int size, int index) {
+    static_assert(TRIVIAL, "openGap needs a trivially copyable T");
+    std::memmove(elements + index + 1, elements + index,
+                 (size - index) * sizeof(T));
+}
+
+/*
+ * name:      closeGap
+ * purpose:   closes up the place of one element at an index
+ * arguments: the elements, how many are in use, and the index, in range
+ *            [0..size)
+ * returns:   none
+ * effects:   moves the elements after the index forward one place, leaving
+ *            the last of the size elements stale
+ */
+template <typename T, typename Allocator>
+void ArrayList<T, Allocator>::closeGap(T *elements, int size, int index) {
+    static_assert(TRIVIAL, "closeGap needs a trivially copyable T");
+    std::memmove(elements + index, elements + index + 1,
+                 (size - index - 1) * sizeof(T));
+}
+
+/*
+ * name:      replaceAt
+ * purpose:   replaces the element at an index
+ * arguments: the new element and the index
+ * returns:   error message if the index is out of range
+ * effects:   none
+ */
+template <typename T, typename Allocator>
+void ArrayList<T, Allocator>::replaceAt(T value, int index) {
+    checkIndex(index);
+    data[index] = std::move(value);
+}
+
+/*
+ * name:      concatenate
+ * purpose:   adds a copy of another ArrayList to the back
+ * arguments: pointer to the other ArrayList, which may be this one
+ * returns:   none
+ * effects:   grows the array at most once
+ */
+template <typename T, typename Allocator>
+void ArrayList<T, Allocator>::concatenate(const ArrayList *other) {
+    int otherSize = other->numItems;
+    reserveFor(otherSize);
+    // other->data is read after reserveFor, so this works when other is
+    // this list
+    if constexpr (TRIVIAL) {
+        if (otherSize > 0) {
+            std::memcpy(data + numItems, other->data, otherSize * sizeof(T));
+        }
+        numItems += otherSize;
+    } else {
+        for (int i = 0; i < otherSize; i++) {
+            Traits::construct(allocator, data + numItems, other->data[i]);
+            numItems++;
+        }
+    }
+}
+
+/*
+ * name:      shrink
+ * purpose:   frees unused capacity
+ * arguments: none
+ * returns:   none
+ * effects:   capacity to size()
+ */
+template <typename T, typename Allocator>
+void ArrayList<T, Allocator>::shrink() {
+    if (capacity > numItems) {
+        resize(numItems);
+    }
+}
+
+/*
+ * name:      resize
+ * purpose:   moves the elements into an array of a new capacity
+ * arguments: the new capacity, at least size()
+ * returns:   none
+ * effects:   frees the old array
+ */
+template <typename T, typename Allocator>
+void ArrayList<T, Allocator>::resize(int newCapacity) {
+    T *newData = newCapacity == 0 ? nullptr
+                                  : Traits::allocate(allocator, newCapacity);
+    if constexpr (TRIVIAL) {
+        if (numItems > 0) {
+            std::memcpy(newData, data, numItems * sizeof(T));
+        }
+    } else {
+        for (int i = 0; i < numItems; i++) {
+            Traits::construct(allocator, newData + i,
+                              std::move_if_noexcept(data[i]));
+            Traits::destroy(allocator, data + i);
+        }
+    }
+    if (data != nullptr) {
+        Traits::deallocate(allocator, data, capacity);
+    }
+    data = newData;
+    capacity = newCapacity;
+}
+
+/*
+ * name:      reserveFor
+ * purpose:   makes room for more elements
+ * arguments: how many elements are about to be added
+ * returns:   none
+ * effects:   grows the array at least as fast as CharArrayList::expand
+ */
+template <typename T, typename Allocator>
+void ArrayList<T, Allocator>::reserveFor(int extra) {
+    if (numItems + extra > capacity) {
+        resize(std::max(numItems + extra, (capacity * 2) + 2));
+    }
+}
+
+/*
+ * name:      destroyAll
+ * purpose:   destroys the elements and frees the array
+ * arguments: none
+ * returns:   none
+ * effects:   data is left dangling for the caller to replace
+ */
+template <typename T, typename Allocator>
+void ArrayList<T, Allocator>::destroyAll() {
+    if constexpr (not std::is_trivially_destructible_v<T>) {
+        for (int i = 0; i < numItems; i++) {
+            Traits::destroy(allocator, data + i);
+        }
+    }
+    if (data != nullptr) {
+        Traits::deallocate(allocator, data, capacity);
+    }
+}
+
+/*
+ * name:      checkIndex
+ * purpose:   makes sure an index refers to an element
+ * arguments: the index
+ * returns:   none
+ * effects:   throws a range_error with the same message CharArrayList uses
+ */
+template <typename T, typename Allocator>
+void ArrayList<T, Allocator>::checkIndex(int index) const {
+    if (index >= numItems or index < 0) {
+        throw std::range_error( "index (" + std::to_string(index) +
+        ") not in range [0.." + std::to_string(numItems) + ")" );
+    }
+}
+
+#endif
@@ -0,0 +1,775 @@
+/*
+ *  CharArrayAllocator.cpp
+ *  Name: Leo Kim
+ *  Date: 10/19/2026
+ *
+ *  Purpose: Implementation of the CharArrayAllocator class. Pooled arrays
+ *           are cached per thread first, so most reuse needs no locking;
+ *           a thread with a full cache passes arrays on to shared overflow
+ *           lists that any thread can take from. On Linux, large arrays are
+ *           anonymous mappings: mremap grows them by moving pages rather
+ *           than copying chars, and they can be backed by huge pages.
+ *           The accounting counters are relaxed atomics, so they are
+ *           exact once the threads changing them are done.
+ *
+ */
+
+#include "CharArrayAllocator.h"
+#include <atomic>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace {
+
+std::atomic<bool> pooling(false);
+std::atomic<bool> hugePages(false);
+
+// arrays no thread cache had room for, one list per capacity class
+struct GlobalPool {
+    std::mutex lock;
+    std::vector<char *> arrays[CharArrayAllocator::MAX_CLASS + 1];
+};
+
+// never destroyed, so arrays released while the program exits are safe
+GlobalPool &globalPool() {
+    static GlobalPool *pool = new GlobalPool;
+    return *pool;
+}
+
+// arrays cached by one thread, handed to the global pool when it exits
+struct ThreadCache {
+    char *arrays[CharArrayAllocator::MAX_CLASS + 1]
+                [CharArrayAllocator::THREAD_CACHE_SIZE];
+    int counts[CharArrayAllocator::MAX_CLASS + 1];
+
+    ThreadCache();
+    ~ThreadCache();
+};
+
+// set once this thread's cache has been destroyed, after which arrays
+// go straight to the global pool
+thread_local bool cacheDestroyed = false;
+thread_local ThreadCache cache;
+
+ThreadCache::ThreadCache() {
+    for (int k = 0; k <= CharArrayAllocator::MAX_CLASS; k++) {
+        counts[k] = 0;
+    }
+}
+
+ThreadCache::~ThreadCache() {
+    cacheDestroyed = true;
+    GlobalPool &pool = globalPool();
+    std::lock_guard<std::mutex> guard(pool.lock);
+    for (int k = 0; k <= CharArrayAllocator::MAX_CLASS; k++) {
+        for (int i = 0; i < counts[k]; i++) {
+            if (pool.arrays[k].size() <
+                CharArrayAllocator::GLOBAL_CACHE_SIZE) {
+                pool.arrays[k].push_back(arrays[k][i]);
+            } else {
+                delete [] arrays[k][i];
+            }
+        }
+    }
+}
+
+// this thread's cache (built on first use), or nullptr during thread exit
+ThreadCache *threadCache() {
+    return cacheDestroyed ? nullptr : &cache;
+}
+
+// the accounting counters, for everything and for each tag
+struct Counters {
+    std::atomic<long> liveBytes;
+    std::atomic<long> peakBytes;
+    std::atomic<long> instances;
+};
+Counters totals;
+Counters tagCounters[CharArrayAllocator::MAX_TAGS];
+
+// tag names, "untagged" for tag 0
+std::mutex tagLock;
+char tagNames[CharArrayAllocator::MAX_TAGS][32] = { "untagged" };
+int numTags = 1;
+
+thread_local int currentTagValue = 0;
+
+std::atomic<long> budgetBytes(0);
+
+// the trim callbacks, with the ids addTrimCallback gave them
+struct TrimCallbacks {
+    std::mutex lock;
+    std::vector<std::pair<int, std::function<long()>>> list;
+    int nextId = 0;
+};
+
+// never destroyed, like the global pool
+TrimCallbacks &trimCallbacks() {
+    static TrimCallbacks *callbacks = new TrimCallbacks;
+    return *callbacks;
+}
+
+// true while this thread is running the trim callbacks or shrinking an
+// array, neither of which may fail for the budget
+thread_local bool budgetExempt = false;
+
+// true while this thread is running the trim callbacks
+thread_local bool runningTrimCallbacks = false;
+
+// sets budgetExempt for as long as it is in scope
+struct BudgetExemption {
+    bool saved;
+    BudgetExemption(bool exempt) : saved(budgetExempt) {
+        budgetExempt = budgetExempt or exempt;
+    }
+    ~BudgetExemption() {
+        budgetExempt = saved;
+    }
+};
+
+// raises a peak counter to at least a value
+void raisePeak(std::atomic<long> &peak, long value) {
+    long seen = peak.load(std::memory_order_relaxed);
+    while (value > seen and
+           not peak.compare_exchange_weak(seen, value,
+                                          std::memory_order_relaxed)) {
+    }
+}
+
+}
+
+/*
+ * name:      sizeClass
+ * purpose:   finds the pool class of a capacity
+ * arguments: an array capacity
+ * returns:   k if the capacity is 2^(k + 2) - 2 for k in [0..MAX_CLASS],
+ *            i.e. one of the capacities expand() produces, or -1 otherwise
+ * effects:   none
+ */
+int CharArrayAllocator::sizeClass(int capacity) {
+    unsigned int n = capacity + 2;
+    if (capacity < 2 or (n & (n - 1)) != 0) {
+        return -1;
+    }
+    int k = __builtin_ctz(n) - 2;
+    return k <= MAX_CLASS ? k : -1;
+}
+
+/*
+ * name:      isLarge
+ * purpose:   determines if an array of a capacity is mapped from the OS
+ * arguments: an array capacity
+ * returns:   true if arrays of this capacity are mmapped
+ * effects:   none
+ */
+bool CharArrayAllocator::isLarge(int capacity) {
+#ifdef __linux__
+    return capacity >= LARGE_ARRAY_SIZE;
+#else
+    (void) capacity;
+    return false;
+#endif
+}
+
+/*
+ * name:      isAligned
+ * purpose:   determines if arrays of a capacity are cache line aligned
+ * arguments: an array capacity
+ * returns:   true if the capacity is a positive multiple of ALIGNMENT. No
+ *            pool class is, so aligned arrays are never pooled
+ * effects:   none
+ */
+bool CharArrayAllocator::isAligned(int capacity) {
+    return capacity > 0 and capacity % ALIGNMENT == 0;
+}
+
+/*
+ * name:      alignedCapacity
+ * purpose:   pads a capacity so allocate returns an aligned array for it
+ * arguments: the number of chars needed
+ * returns:   the smallest multiple of ALIGNMENT that is at least that
+ *            many, or 0 for 0
+ * effects:   throws bad_alloc if that would not fit in an int
+ */
+int CharArrayAllocator::alignedCapacity(int capacity) {
+    long padded = (static_cast<long>(capacity) + ALIGNMENT - 1) /
+                  ALIGNMENT * ALIGNMENT;
+    if (padded > INT_MAX) {
+        throw std::bad_alloc();
+    }
+    return padded;
+}
+
+/*
+ * name:      allocate
+ * purpose:   gets an array for a CharArrayList
+ * arguments: the capacity of the array
+ * returns:   an array of that many chars (contents undefined), or nullptr
+ *            for a capacity of 0
+ * effects:   takes the array from the pool if pooling is on and one is
+ *            cached, otherwise from the heap. An array whose capacity is a
+ *            multiple of ALIGNMENT starts on an ALIGNMENT byte boundary.
+ *            Charges it to the tag, first
+ *            running the trim callbacks and then throwing
+ *            CharArrayBudgetExceeded if it would go past the budget
+ */
+char *CharArrayAllocator::allocate(int capacity, int tag) {
+    if (capacity == 0) {
+        return nullptr;
+    }
+    charge(capacity, tag);
+
+#ifdef __linux__
+    if (isLarge(capacity)) {
+        void *array = mmap(nullptr, capacity, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (array == MAP_FAILED) {
+            credit(capacity, tag);
+            throw std::bad_alloc();
+        }
+        if (hugePages.load(std::memory_order_relaxed)) {
+            madvise(array, capacity, MADV_HUGEPAGE);
+        }
+        return static_cast<char *>(array);
+    }
+#endif
+
+    int k = sizeClass(capacity);
+    if (k != -1 and pooling.load(std::memory_order_relaxed)) {
+        ThreadCache *local = threadCache();
+        if (local != nullptr and local->counts[k] > 0) {
+            return local->arrays[k][--local->counts[k]];
+        }
+        GlobalPool &pool = globalPool();
+        std::lock_guard<std::mutex> guard(pool.lock);
+        if (not pool.arrays[k].empty()) {
+            char *array = pool.arrays[k].back();
+            pool.arrays[k].pop_back();
+            return array;
+        }
+    }
+    try {
+        if (isAligned(capacity)) {
+            return new (std::align_val_t(ALIGNMENT)) char[capacity];
+        }
+        return new char[capacity];
+    } catch (const std::bad_alloc &) {
+        credit(capacity, tag);
+        throw;
+    }
+}
+
+/*
+ * name:      release
+ * purpose:   gives back an array from allocate
+ * arguments: the array (may be nullptr), and the capacity and tag it was
+ *            allocated with
+ * returns:   none
+ * effects:   keeps the array in the pool if pooling is on and there is
+ *            room for it, otherwise frees it
+ */
+void CharArrayAllocator::release(char *array, int capacity, int tag) {
+    if (array == nullptr) {
+        return;
+    }
+    credit(capacity, tag);
+
+#ifdef __linux__
+    if (isLarge(capacity)) {
+        munmap(array, capacity);
+        return;
+    }
+#endif
+
+    int k = sizeClass(capacity);
+    if (k != -1 and pooling.load(std::memory_order_relaxed)) {
+        ThreadCache *local = threadCache();
+        if (local != nullptr and local->counts[k] < THREAD_CACHE_SIZE) {
+            local->arrays[k][local->counts[k]++] = array;
+            return;
+        }
+        GlobalPool &pool = globalPool();
+        std::lock_guard<std::mutex> guard(pool.lock);
+        if (pool.arrays[k].size() < GLOBAL_CACHE_SIZE) {
+            pool.arrays[k].push_back(array);
+            return;
+        }
+    }
+    if (isAligned(capacity)) {
+        ::operator delete[](array, std::align_val_t(ALIGNMENT));
+        return;
+    }
+    delete [] array;
+}
+
+/*
+ * name:      reallocate
+ * purpose:   moves the contents of an array into one of a new capacity
+ * arguments: the array (may be nullptr), its capacity, the new capacity,
+ *            how many chars at the front of the array to keep, and the tag
+ *            the array is charged to
+ * returns:   the new array, or nullptr for a new capacity of 0
+ * effects:   the old array must not be used afterwards. Growing one large
+ *            array into another remaps its pages instead of copying them
+ */
+char *CharArrayAllocator::reallocate(char *array, int capacity,
+                                     int newCapacity, int keep, int tag) {
+    // shrinking frees memory overall, so it never fails for the budget
+    // even though both arrays exist for a moment
+    BudgetExemption exemption(newCapacity <= capacity);
+
+#ifdef __linux__
+    if (array != nullptr and isLarge(capacity) and isLarge(newCapacity)) {
+        charge(newCapacity - capacity, tag);
+        void *moved = mremap(array, capacity, newCapacity, MREMAP_MAYMOVE);
+        if (moved == MAP_FAILED) {
+            credit(newCapacity - capacity, tag);
+            throw std::bad_alloc();
+        }
+        if (hugePages.load(std::memory_order_relaxed)) {
+            madvise(moved, newCapacity, MADV_HUGEPAGE);
+        }
+        return static_cast<char *>(moved);
+    }
+#endif
+
+    char *newArray = allocate(newCapacity, tag);
+    if (keep > 0) {
+        std::memcpy(newArray, array, keep);
+    }
+    release(array, capacity, tag);
+    return newArray;
+}
+
+/*
+ * name:      setPooling
+ * purpose:   turns the pool on or off
+ * arguments: true to start pooling arrays
+ * returns:   none
+ * effects:   turning it off does not free cached arrays; see drainPool
+ */
+void CharArrayAllocator::setPooling(bool on) {
+    pooling.store(on);
+}
+
+/*
+ * name:      isPooling
+ * purpose:   determines if the pool is on
+ * arguments: none
+ * returns:   true if released arrays are being pooled
+ * effects:   none
+ */
+bool CharArrayAllocator::isPooling() {
+    return pooling.load();
+}
+
+/*
+ * name:      drainPool
+ * purpose:   frees the arrays cached by this thread and the shared lists
+ * arguments: none
+ * returns:   the number of bytes freed
+ * effects:   other threads keep their own caches until they exit
+ */
+long CharArrayAllocator::drainPool() {
+    long freed = 0;
+    ThreadCache *local = threadCache();
+    if (local != nullptr) {
+        for (int k = 0; k <= MAX_CLASS; k++) {
+            for (int i = 0; i < local->counts[k]; i++) {
+                delete [] local->arrays[k][i];
+                freed += (1L << (k + 2)) - 2;
+            }
+            local->counts[k] = 0;
+        }
+    }
+
+    GlobalPool &pool = globalPool();
+    std::lock_guard<std::mutex> guard(pool.lock);
+    for (int k = 0; k <= MAX_CLASS; k++) {
+        for (char *array : pool.arrays[k]) {
+            delete [] array;
+            freed += (1L << (k + 2)) - 2;
+        }
+        pool.arrays[k].clear();
+    }
+    return freed;
+}
+
+/*
+ * name:      setHugePages
+ * purpose:   turns transparent huge page backing of large arrays on or off
+ * arguments: true to ask for huge pages
+ * returns:   none
+ * effects:   applies to large arrays mapped or grown from now on; fewer
+ *            TLB misses when scanning them. Has no effect outside Linux
+ */
+void CharArrayAllocator::setHugePages(bool on) {
+    hugePages.store(on);
+}
+
+/*
+ * name:      CharArrayBudgetExceeded constructor
+ * purpose:   initialize the exception thrown for going over the budget
+ * arguments: the size of the array that did not fit and the budget
+ * returns:   none
+ * effects:   none
+ */
+CharArrayBudgetExceeded::CharArrayBudgetExceeded(long requested,
+                                                 long budget) {
+    std::snprintf(message, sizeof(message),
+                  "cannot allocate %ld bytes within budget of %ld bytes",
+                  requested, budget);
+}
+
+/*
+ * name:      what
+ * purpose:   describes the exception
+ * arguments: none
+ * returns:   the message
+ * effects:   none
+ */
+const char *CharArrayBudgetExceeded::what() const noexcept {
+    return message;
+}
+
+/*
+ * name:      stats
+ * purpose:   reports the memory in use by all CharArrayLists
+ * arguments: none
+ * returns:   the live and peak bytes and the number of CharArrayLists
+ * effects:   none
+ */
+CharArrayAllocator::Stats CharArrayAllocator::stats() {
+    return { totals.liveBytes.load(), totals.peakBytes.load(),
+             totals.instances.load() };
+}
+
+/*
+ * name:      stats
+ * purpose:   reports the memory in use by the CharArrayLists of one tag
+ * arguments: the tag
+ * returns:   the live and peak bytes charged to the tag and the number of
+ *            CharArrayLists made under it
+ * effects:   throws a range_error for a tag that was not registered
+ */
+CharArrayAllocator::Stats CharArrayAllocator::stats(int tag) {
+    tagName(tag);
+    Counters &counters = tagCounters[tag];
+    return { counters.liveBytes.load(), counters.peakBytes.load(),
+             counters.instances.load() };
+}
+
+/*
+ * name:      registerTag
+ * purpose:   gets a tag to charge memory to
+ * arguments: a name for the tag (at most 31 chars are kept)
+ * returns:   the tag; registering a name twice gives the same tag
+ * effects:   throws a runtime_error once MAX_TAGS tags exist
+ */
+int CharArrayAllocator::registerTag(const char *name) {
+    std::lock_guard<std::mutex> guard(tagLock);
+    for (int tag = 0; tag < numTags; tag++) {
+        if (std::strncmp(tagNames[tag], name, sizeof(tagNames[tag]) - 1)
+            == 0) {
+            return tag;
+        }
+    }
+    if (numTags == MAX_TAGS) {
+        throw std::runtime_error("cannot register more than " +
+                                 std::to_string(MAX_TAGS) + " tags");
+    }
+    std::strncpy(tagNames[numTags], name, sizeof(tagNames[numTags]) - 1);
+    return numTags++;
+}
+
+/*
+ * name:      tagName
+ * purpose:   gets the name of a tag
+ * arguments: the tag
+ * returns:   the name it was registered with
+ * effects:   throws a range_error for a tag that was not registered
+ */
+const char *CharArrayAllocator::tagName(int tag) {
+    std::lock_guard<std::mutex> guard(tagLock);
+    if (tag >= numTags or tag < 0) {
+        throw std::range_error( "tag (" + std::to_string(tag) +
+        ") not in range [0.." + std::to_string(numTags) + ")" );
+    }
+    return tagNames[tag];
+}
+
+/*
+ * name:      currentTag
+ * purpose:   gets the tag new CharArrayLists on this thread are charged to
+ * arguments: none
+ * returns:   the tag of the innermost TagScope, or 0 outside any
+ * effects:   none
+ */
+int CharArrayAllocator::currentTag() {
+    return currentTagValue;
+}
+
+/*
+ * name:      instanceCreated
+ * purpose:   counts a new CharArrayList
+ * arguments: its tag
+ * returns:   none
+ * effects:   called by every CharArrayList constructor
+ */
+void CharArrayAllocator::instanceCreated(int tag) {
+    totals.instances.fetch_add(1, std::memory_order_relaxed);
+    tagCounters[tag].instances.fetch_add(1, std::memory_order_relaxed);
+}
+
+/*
+ * name:      instanceDestroyed
+ * purpose:   stops counting a CharArrayList
+ * arguments: its tag
+ * returns:   none
+ * effects:   called by the CharArrayList destructor
+ */
+void CharArrayAllocator::instanceDestroyed(int tag) {
+    totals.instances.fetch_sub(1, std::memory_order_relaxed);
+    tagCounters[tag].instances.fetch_sub(1, std::memory_order_relaxed);
+}
+
+/*
+ * name:      TagScope constructor
+ * purpose:   starts charging this thread's new CharArrayLists to a tag
+ * arguments: the tag
+ * returns:   none
+ * effects:   throws a range_error for a tag that was not registered
+ */
+CharArrayAllocator::TagScope::TagScope(int tag) {
+    tagName(tag);
+    previous = currentTagValue;
+    currentTagValue = tag;
+}
+
+/*
+ * name:      TagScope destructor
+ * purpose:   goes back to the tag in use before the scope
+ * arguments: none
+ * returns:   none
+ * effects:   none
+ */
+CharArrayAllocator::TagScope::~TagScope() {
+    currentTagValue = previous;
+}
+
+/*
+ * name:      ContainerAllocator constructor
+ * purpose:   makes an allocator for a container of chars
+ * arguments: none
+ * returns:   none
+ * effects:   charges what it allocates to the current tag
+ */
+CharArrayAllocator::ContainerAllocator::ContainerAllocator() {
+    tag = currentTag();
+}
+
+/*
+ * name:      ContainerAllocator allocate
+ * purpose:   gets an array for the container
+ * arguments: its size, which must fit in an int
+ * returns:   the array
+ * effects:   see CharArrayAllocator::allocate
+ */
+char *CharArrayAllocator::ContainerAllocator::allocate(std::size_t n) {
+    if (n > INT_MAX) {
+        throw std::bad_alloc();
+    }
+    return CharArrayAllocator::allocate(n, tag);
+}
+
+/*
+ * name:      ContainerAllocator deallocate
+ * purpose:   gives back an array from allocate
+ * arguments: the array and its size
+ * returns:   none
+ * effects:   see CharArrayAllocator::release
+ */
+void CharArrayAllocator::ContainerAllocator::deallocate(char *array,
+                                                        std::size_t n) {
+    release(array, n, tag);
+}
+
+/*
+ * name:      select_on_container_copy_construction
+ * purpose:   picks the allocator for a copy of a container
+ * arguments: none
+ * returns:   an allocator charging the current tag, as a copied
+ *            CharArrayList is charged
+ * effects:   none
+ */
+CharArrayAllocator::ContainerAllocator
+CharArrayAllocator::ContainerAllocator::select_on_container_copy_construction()
+    const {
+    return ContainerAllocator();
+}
+
+/*
+ * name:      ContainerAllocator operator==
+ * purpose:   determines if two allocators can free each other's arrays
+ * arguments: the other allocator
+ * returns:   true if they charge the same tag
+ * effects:   none
+ */
+bool CharArrayAllocator::ContainerAllocator::operator==(
+    const ContainerAllocator &other) const {
+    return tag == other.tag;
+}
+
+/*
+ * name:      setBudget
+ * purpose:   limits the memory CharArrayLists may use
+ * arguments: the most bytes of array capacity that may be in use, or 0
+ *            for no limit
+ * returns:   none
+ * effects:   only growth is checked, so memory already in use past a new
+ *            budget is left alone
+ */
+void CharArrayAllocator::setBudget(long bytes) {
+    if (bytes < 0) {
+        throw std::range_error("budget must not be negative");
+    }
+    budgetBytes.store(bytes);
+}
+
+/*
+ * name:      budget
+ * purpose:   gets the budget
+ * arguments: none
+ * returns:   the budget in bytes, 0 if there is none
+ * effects:   none
+ */
+long CharArrayAllocator::budget() {
+    return budgetBytes.load();
+}
+
+/*
+ * name:      addTrimCallback
+ * purpose:   registers something to run when an array would go over budget
+ * arguments: a function that frees what memory it can and returns how
+ *            many bytes it freed. It runs in the middle of the allocation
+ *            that went over budget, on whichever thread made it, so it may
+ *            only free memory no other code can be using at that moment
+ *            (its own caches, say). CharArrayList::trimAll does not qualify
+ *            and does nothing when called from here
+ * returns:   an id for removeTrimCallback
+ * effects:   callbacks run in the order they were added, one thread at a
+ *            time, and their own allocations are not held to the budget
+ */
+int CharArrayAllocator::addTrimCallback(std::function<long()> callback) {
+    TrimCallbacks &callbacks = trimCallbacks();
+    std::lock_guard<std::mutex> guard(callbacks.lock);
+    callbacks.list.emplace_back(callbacks.nextId, std::move(callback));
+    return callbacks.nextId++;
+}
+
+/*
+ * name:      removeTrimCallback
+ * purpose:   unregisters a trim callback
+ * arguments: the id addTrimCallback gave it
+ * returns:   none
+ * effects:   does nothing for an id that is not registered
+ */
+void CharArrayAllocator::removeTrimCallback(int id) {
+    TrimCallbacks &callbacks = trimCallbacks();
+    std::lock_guard<std::mutex> guard(callbacks.lock);
+    for (size_t i = 0; i < callbacks.list.size(); i++) {
+        if (callbacks.list[i].first == id) {
+            callbacks.list.erase(callbacks.list.begin() + i);
+            return;
+        }
+    }
+}
+
+/*
+ * name:      inTrimCallback
+ * purpose:   tells code that may be running as a trim callback
+ * arguments: none
+ * returns:   true while this thread is running the trim callbacks
+ * effects:   none
+ */
+bool CharArrayAllocator::inTrimCallback() {
+    return runningTrimCallbacks;
+}
+
+/*
+ * name:      charge
+ * purpose:   counts memory about to be handed out
+ * arguments: the number of bytes and the tag to charge them to
+ * returns:   none
+ * effects:   if the bytes would take liveBytes past the budget, runs the
+ *            trim callbacks and tries again, then throws
+ *            CharArrayBudgetExceeded if they still do not fit
+ */
+void CharArrayAllocator::charge(long bytes, int tag) {
+    long live = totals.liveBytes.fetch_add(bytes, std::memory_order_relaxed)
+                + bytes;
+    long limit = budgetBytes.load(std::memory_order_relaxed);
+    if (limit > 0 and live > limit and not budgetExempt) {
+        totals.liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+        trimForBudget();
+        live = totals.liveBytes.fetch_add(bytes, std::memory_order_relaxed)
+               + bytes;
+        if (live > limit) {
+            totals.liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+            throw CharArrayBudgetExceeded(bytes, limit);
+        }
+    }
+    raisePeak(totals.peakBytes, live);
+
+    Counters &counters = tagCounters[tag];
+    long tagLive = counters.liveBytes.fetch_add(bytes,
+                                                std::memory_order_relaxed)
+                   + bytes;
+    raisePeak(counters.peakBytes, tagLive);
+}
+
+/*
+ * name:      credit
+ * purpose:   stops counting memory that has been given back
+ * arguments: the number of bytes and the tag they were charged to
+ * returns:   none
+ * effects:   none
+ */
+void CharArrayAllocator::credit(long bytes, int tag) {
+    totals.liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+    tagCounters[tag].liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+/*
+ * name:      trimForBudget
+ * purpose:   runs the trim callbacks
+ * arguments: none
+ * returns:   none
+ * effects:   the callbacks' own allocations are exempt from the budget
+ */
+void CharArrayAllocator::trimForBudget() {
+    TrimCallbacks &callbacks = trimCallbacks();
+    std::lock_guard<std::mutex> guard(callbacks.lock);
+    BudgetExemption exemption(true);
+    runningTrimCallbacks = true;
+    try {
+        for (auto &entry : callbacks.list) {
+            entry.second();
+        }
+    } catch (...) {
+        runningTrimCallbacks = false;
+        throw;
+    }
+    runningTrimCallbacks = false;
+}
@@ -0,0 +1,138 @@
+/*
+ *  CharArrayAllocator.h
+ *  Name: Leo Kim
+ *  Date: 10/19/2026
+ *
+ *  Purpose: Class declaration for the CharArrayAllocator class. Every array
+ *           a CharArrayList uses comes from and goes back to this class, as
+ *           do the chars of CharArrayListColumn and CharArrayListInterner.
+ *           When pooling is on, released arrays whose capacity is one of
+ *           the sizes expand() grows through (2, 6, 14, 30, ...) are kept
+ *           for reuse instead of being returned to the heap. Very large
+ *           arrays are mapped straight from the OS so they can grow without
+ *           being copied. Arrays whose capacity is a multiple of 64 start
+ *           on a cache line. It also keeps count of the memory in use,
+ *           attributed to tags, and can hold it under a budget.
+ *
+ */
+#ifndef CHAR_ARRAY_ALLOCATOR_H
+#define CHAR_ARRAY_ALLOCATOR_H
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+
+// thrown when an array would take the memory in use past the budget, even
+// after the trim callbacks have run
+class CharArrayBudgetExceeded : public std::bad_alloc {
+public:
+    CharArrayBudgetExceeded(long requested, long budget);
+    const char *what() const noexcept override;
+
+private:
+    char message[96];
+};
+
+class CharArrayAllocator {
+public:
+    // the tag arguments say which tag the array is charged to (see
+    // registerTag); 0 is untagged
+    static char *allocate(int capacity, int tag = 0);
+    static void release(char *array, int capacity, int tag = 0);
+    static char *reallocate(char *array, int capacity, int newCapacity,
+                            int keep, int tag = 0);
+
+    static void setPooling(bool on);
+    static bool isPooling();
+    static long drainPool();
+    static void setHugePages(bool on);
+
+    // arrays whose capacity is a multiple of ALIGNMENT start on a cache
+    // line; alignedCapacity rounds a capacity up to one
+    static const int ALIGNMENT = 64;
+    static int alignedCapacity(int capacity);
+
+    // accounting, for all arrays handed out and not yet released
+    struct Stats {
+        long liveBytes;     // total capacity of those arrays
+        long peakBytes;     // the most liveBytes has ever been
+        long instances;     // CharArrayLists alive
+    };
+    static Stats stats();
+    static Stats stats(int tag);
+    static int registerTag(const char *name);
+    static const char *tagName(int tag);
+    static int currentTag();
+    static void instanceCreated(int tag);
+    static void instanceDestroyed(int tag);
+
+    // Charges what the CharArrayLists made on this thread allocate to a
+    // tag for as long as it is in scope
+    class TagScope {
+    public:
+        TagScope(int tag);
+        TagScope(const TagScope &other) = delete;
+        TagScope &operator=(const TagScope &other) = delete;
+        ~TagScope();
+
+    private:
+        int previous;
+    };
+
+    // A standard allocator of chars for containers (std::vector<char,
+    // CharArrayAllocator::ContainerAllocator>) that takes its arrays from
+    // allocate, so they are counted and held to the budget like any
+    // CharArrayList's. They are charged to the tag that was current when
+    // the allocator was made; a copy of the container is charged to the
+    // tag current when it is copied
+    class ContainerAllocator {
+    public:
+        typedef char value_type;
+        typedef std::true_type propagate_on_container_move_assignment;
+        typedef std::true_type propagate_on_container_swap;
+        // chars are all it can allocate
+        template <typename T>
+        struct rebind {
+            static_assert(std::is_same_v<T, char>, "only allocates chars");
+            typedef ContainerAllocator other;
+        };
+
+        ContainerAllocator();
+        char *allocate(std::size_t n);
+        void deallocate(char *array, std::size_t n);
+        ContainerAllocator select_on_container_copy_construction() const;
+        bool operator==(const ContainerAllocator &other) const;
+
+    private:
+        int tag;
+    };
+
+    // budget for liveBytes, 0 for none
+    static void setBudget(long bytes);
+    static long budget();
+    static int addTrimCallback(std::function<long()> callback);
+    static void removeTrimCallback(int id);
+    static bool inTrimCallback();
+
+    // the largest capacity class kept in the pool is 2^(MAX_CLASS + 2) - 2
+    static const int MAX_CLASS = 18;
+    // how many arrays of each class a thread keeps before handing them to
+    // the shared overflow lists, and how many those lists keep
+    static const int THREAD_CACHE_SIZE = 8;
+    static const int GLOBAL_CACHE_SIZE = 64;
+    // arrays of at least this many chars are mapped with mmap and grown
+    // with mremap where the OS has it
+    static const int LARGE_ARRAY_SIZE = 1 << 21;
+    static const int MAX_TAGS = 32;
+
+private:
+    static int sizeClass(int capacity);
+    static bool isLarge(int capacity);
+    static bool isAligned(int capacity);
+    static void charge(long bytes, int tag);
+    static void credit(long bytes, int tag);
+    static void trimForBudget();
+};
+
+#endif
@@ -10,7 +10,56 @@
  */
 
 #include "CharArrayList.h"
+#include "CharArrayAllocator.h"
+#include "ArrayList.h"
 #include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <bit>
+#include <vector>
+#include <cstring>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <cerrno>
+#include <sys/uio.h>
+#include <unistd.h>
+
+// every CharArrayList with auto-trim turned on, for trimAll
+static std::mutex autoTrimLock;
+static std::set<CharArrayList *> autoTrimLists;
+
+// long scans ask for memory PREFETCH_DISTANCE chars ahead of where they
+// are reading. Building with -DCHAR_ARRAY_LIST_NO_PREFETCH leaves the hints
+// out, which is how benchmarks.cpp measures what they are worth
+#ifdef CHAR_ARRAY_LIST_NO_PREFETCH
+#define PREFETCH(address)
+#else
+#define PREFETCH(address) __builtin_prefetch(address)
+#endif
+static const int PREFETCH_DISTANCE = 1024;
+
+// scans go through the chars a cache line at a time
+static const int BLOCK = CharArrayAllocator::ALIGNMENT;
+
+// the sampled code point index: samples[j] is the index of the first char
+// of code point j * every, and count is the number of code points
+struct CharArrayList::CodePointIndex {
+    int every;
+    int count;
+    std::vector<int> samples;
+};
+
+/*
+ * name:      isCodePointStart
+ * purpose:   determines if a char starts a UTF-8 code point
+ * arguments: the char
+ * returns:   true unless it is a continuation char (10xxxxxx)
+ * effects:   none
+ */
+static bool isCodePointStart(char c) {
+    return (static_cast<unsigned char>(c) & 0xC0) != 0x80;
+}
 
 /*
  * name:      CharArrayList default constructor
@@ -24,6 +73,14 @@ CharArrayList::CharArrayList() {
     numItems = 0;
     capacity = 0;
     data = nullptr;
+    codePoints = nullptr;
+    hashValid = false;
+    trimThreshold = 0;
+    borrowed = false;
+    generation = 0;
+    aligned = false;
+    tag = CharArrayAllocator::currentTag();
+    CharArrayAllocator::instanceCreated(tag);
 }
 
 /*
@@ -37,10 +94,18 @@ CharArrayList::CharArrayList(char c) {
     // initializing all the private member variables
     numItems = 1;
     capacity = 1;
+    codePoints = nullptr;
+    hashValid = false;
+    trimThreshold = 0;
+    borrowed = false;
+    generation = 0;
+    aligned = false;
+    tag = CharArrayAllocator::currentTag();
     
     // adding the first char to the list
-    data = new char[1];
+    data = CharArrayAllocator::allocate(1, tag);
     data[0] = c;
+    CharArrayAllocator::instanceCreated(tag);
 }
 
 /*
@@ -55,7 +120,15 @@ CharArrayList::CharArrayList(char arr[], int size) {
     // the array list
     numItems = 0;
     capacity = size;
-    data = new char[size];
+    tag = CharArrayAllocator::currentTag();
+    data = CharArrayAllocator::allocate(size, tag);
+    codePoints = nullptr;
+    hashValid = false;
+    trimThreshold = 0;
+    borrowed = false;
+    generation = 0;
+    aligned = false;
+    CharArrayAllocator::instanceCreated(tag);
     
     // Adding each member of the given array to the array list
     for (int i = 0; i < size; i++){
@@ -68,28 +141,75 @@ CharArrayList::CharArrayList(char arr[], int size) {
  * purpose:   copy constructor for the CharArrayList class
  * arguments: Address of another CharArrayList
  * returns:   none
- * effects:   makes a deep copy of the given CharArrayList
+ * effects:   makes a deep copy of the given CharArrayList, and of its code
+ *            point index if it has one
  */
 CharArrayList::CharArrayList(const CharArrayList &other) {
     // initializing the private member variables and allocating heap space for
     // the array list
     numItems = 0;
     capacity = other.size();
-    data = new char[capacity];
+    tag = CharArrayAllocator::currentTag();
+    data = CharArrayAllocator::allocate(capacity, tag);
+    codePoints = nullptr;
+    hashValid = false;
+    trimThreshold = 0;
+    borrowed = false;
+    generation = 0;
+    aligned = false;
+    CharArrayAllocator::instanceCreated(tag);
+
+    // copy the elements of the given CharArrayList over in one go
+    std::copy(other.data, other.data + other.numItems, data);
+    numItems = other.numItems;
 
-    // adding each member of the given CharArrayList to the newly created array 
-    // list
-    for (int i = 0; i < capacity; i++) {
-        pushAtBack(other.elementAt(i));
+    // the contents are the same, so the index is too
+    if (other.codePoints != nullptr) {
+        codePoints = new CodePointIndex(*other.codePoints);
     }
 }
 
+/*
+ * name:      CharArrayList move constructor
+ * purpose:   move constructor for the CharArrayList class
+ * arguments: a CharArrayList that is about to go away
+ * returns:   none
+ * effects:   takes over the array of the given CharArrayList, leaving it
+ *            empty. The aligned layout setting and the code point index
+ *            are taken over with the array; the auto-trim setting is not
+ */
+CharArrayList::CharArrayList(CharArrayList &&other) {
+    numItems = other.numItems;
+    capacity = other.capacity;
+    data = other.data;
+    borrowed = other.borrowed;
+    codePoints = other.codePoints;
+    cachedHash.store(other.cachedHash.load(std::memory_order_relaxed),
+                     std::memory_order_relaxed);
+    hashValid.store(other.hashValid.load(std::memory_order_relaxed),
+                    std::memory_order_relaxed);
+    trimThreshold = 0;
+    generation = 0;
+    aligned = other.aligned;
+    tag = other.tag;
+    CharArrayAllocator::instanceCreated(tag);
+
+    other.numItems = 0;
+    other.capacity = 0;
+    other.data = nullptr;
+    other.borrowed = false;
+    other.codePoints = nullptr;
+    other.hashValid = false;
+    other.generation++;
+}
+
 /*
  * name:      CharArrayList assignment operator definition
  * purpose:   used to make a deepcopy when assigning CharArrayLists to eachother
  * arguments: address of the other CharArrayList
  * returns:   none
- * effects:   makes a deep copy of the given CharArrayList
+ * effects:   makes a deep copy of the given CharArrayList. If the new array
+ *            cannot be allocated the list is left unchanged
  */
 CharArrayList &CharArrayList::operator=(const CharArrayList &other) {
     // Check to see if the assignment operator is assigning two equivalent
@@ -98,23 +218,66 @@ CharArrayList &CharArrayList::operator=(const CharArrayList &other) {
         return *this;
     }
 
-    // Setting the private member variables equal to the given CharArrayList,
-    // making sure to deep copy the neccesary elements
-    capacity = other.size();
-    numItems = 0;
-    char *temp = data;
-    data = new char[capacity];
-    delete [] temp;
-    
-    // adding each member of the given CharArrayList to the newly assigned 
-    // array list
-    for (int i = 0; i < capacity; i++) {
-        pushAtBack(other.elementAt(i));
-    }
+    // copy the elements of the given CharArrayList into a new array first,
+    // so the list is left as it was if the allocation throws
+    int newCapacity = paddedCapacity(other.size());
+    char *new_data = allocateArray(newCapacity, other.size());
+    std::copy(other.data, other.data + other.numItems, new_data);
+
+    // then give up the old array and take the new one
+    releaseData();
+    contentsChanged();
+    data = new_data;
+    capacity = newCapacity;
+    numItems = other.numItems;
+    reindexFrom(0);
         
     return *this;
 }
 
+/*
+ * name:      CharArrayList move assignment operator definition
+ * purpose:   used when assigning a CharArrayList that is about to go away
+ * arguments: the other CharArrayList
+ * returns:   none
+ * effects:   frees the current array and takes over the array of the given
+ *            CharArrayList, leaving it empty. Settings such as the code
+ *            point index stay as they were, except the aligned layout
+ *            setting, which comes with the array
+ */
+CharArrayList &CharArrayList::operator=(CharArrayList &&other) {
+    if (this == &other) {
+        return *this;
+    }
+
+    releaseData();
+    if (tag != other.tag) {
+        // the array stays charged to the tag it was allocated under
+        CharArrayAllocator::instanceDestroyed(tag);
+        tag = other.tag;
+        CharArrayAllocator::instanceCreated(tag);
+    }
+    numItems = other.numItems;
+    capacity = other.capacity;
+    data = other.data;
+    borrowed = other.borrowed;
+    aligned = other.aligned;
+    cachedHash.store(other.cachedHash.load(std::memory_order_relaxed),
+                     std::memory_order_relaxed);
+    hashValid.store(other.hashValid.load(std::memory_order_relaxed),
+                    std::memory_order_relaxed);
+
+    other.numItems = 0;
+    other.capacity = 0;
+    other.data = nullptr;
+    other.borrowed = false;
+    other.hashValid = false;
+    other.generation++;
+    reindexFrom(0);
+    other.reindexFrom(0);
+    return *this;
+}
+
 
 /*
  * name:      CharArrayList destructor
@@ -124,30 +287,39 @@ CharArrayList &CharArrayList::operator=(const CharArrayList &other) {
  * effects:   frees memory allocated by CharArraylist instances
  */
 CharArrayList::~CharArrayList() {
+    // leave the auto-trim registry before going away
+    if (trimThreshold > 0) {
+        std::lock_guard<std::mutex> guard(autoTrimLock);
+        autoTrimLists.erase(this);
+    }
+
     // Deallocating the heap memory used in the CharArrayList
-    delete [] data;
+    releaseData();
+    delete codePoints;
+    CharArrayAllocator::instanceDestroyed(tag);
 }
 
 /*
- * name:      size
- * purpose:   determine the number of items in the CharArrayList
- * arguments: none
- * returns:   number of elements currently stored in the CharArrayList
- * effects:   none
+ * name:      throwIndexError
+ * purpose:   reports an index outside the CharArrayList
+ * arguments: the bad index
+ * returns:   never
+ * effects:   throws a range_error naming the index and the valid range
  */
-int CharArrayList::size() const {
-    return numItems;
+void CharArrayList::throwIndexError(int index) const {
+    throw std::range_error( "index (" + std::to_string(index) + 
+    ") not in range [0.." + std::to_string(numItems) + ")" );
 }
 
 /*
- * name:      isEmpty
- * purpose:   determines if the CharArrayList is empty or not
- * arguments: none
- * returns:   true if CharArrayList contains no elements, false otherwise
- * effects:   none
+ * name:      throwEmptyError
+ * purpose:   reports an operation that needs a non-empty CharArrayList
+ * arguments: the message to report
+ * returns:   never
+ * effects:   throws a runtime_error with the message
  */
-bool CharArrayList::isEmpty() const {
-    return numItems == 0;
+void CharArrayList::throwEmptyError(const char *message) {
+    throw std::runtime_error(message);
 }
 
 /*
@@ -160,67 +332,16 @@ bool CharArrayList::isEmpty() const {
 void CharArrayList::clear() {
     // clear existing heap memory
     if (data != nullptr){
-        delete [] data;
+        releaseData();
     }
     
 
     // reset private member variables
+    contentsChanged();
     data = nullptr;
     numItems = 0;
     capacity = 0;
-}
-
-/*
- * name:      first
- * purpose:   determines the first element of the CharArrayList
- * arguments: none
- * returns:   the first element of the CharArrayList or an error if the list
- *            is empty
- * effects:   none
- */
-char CharArrayList::first() const {
-    if (isEmpty()){
-        // if the CharArrayList is empty throw an error message
-        throw std::runtime_error("cannot get first of empty ArrayList");
-    } else {
-        return data[0];
-    }
-}
-
-/*
- * name:      last
- * purpose:   determines the last element of the CharArrayList
- * arguments: none
- * returns:   the last element of the CharArrayList or an error if the list
- *            is empty
- * effects:   none
- */
-char CharArrayList::last() const {
-    if (isEmpty()){
-        // if the CharArrayList is empty throw an error message
-        throw std::runtime_error("cannot get last of empty ArrayList");
-    } else {
-        return data[numItems - 1];
-    }
-}
-
-/*
- * name:      elementAt
- * purpose:   determines the element at a given index in the CharArrayList
- * arguments: index of element
- * returns:   the corresponding element of the CharArrayList or an error if the 
- *            list is empty
- * effects:   none
- */
-char CharArrayList::elementAt(int index) const {
-    if (index >= numItems or index < 0){
-        // if the index is out of range of the CharArrayList, throw an error 
-        // message
-        throw std::range_error( "index (" + std::to_string(index) + 
-        ") not in range [0.." + std::to_string(numItems) + ")" );
-    } else {
-        return data[index];
-    }
+    reindexFrom(0);
 }
 
 
@@ -237,35 +358,16 @@ void CharArrayList::pushAtFront(char c) {
     if (capacity <= numItems) {
         expand();
     }
+    contentsChanged();
     
     // Add the given char to the start of the array list and shift every other 
     //element one place back
-    char temp1 = c;
-    char temp2;
-    for (int i = 0; i <= numItems; i++) {
-        temp2 = data[i];
-        data[i] = temp1;
-        temp1 = temp2;
-    }
+    ArrayList<char>::openGap(data, numItems, 0);
+    data[0] = c;
     numItems++;
-}
-
-/*
- * name:      pushAtBack
- * purpose:   push the provided integer into the back of the CharArrayList
- * arguments: a char to add to the back of the list
- * returns:   none
- * effects:   increases num elements of CharArrayList by 1,
- *            adds element to list
- */
-void CharArrayList::pushAtBack(char c) {
-    // if the array list is at capacity, expand it
-    if (numItems >= capacity) {
-        expand();
+    if (codePoints != nullptr) {
+        charInserted(0);
     }
-    // add the given char to the end of the array list
-    data[numItems] = c;
-    numItems++;
 }
 
 /*
@@ -277,18 +379,89 @@ void CharArrayList::pushAtBack(char c) {
  *            and recycles the old array
  */
 void CharArrayList::expand() {
-    // increase the array list capacity and allocate new space on the heap
-    capacity = (capacity * 2) + 2;
-    char *new_data = new char[capacity];
-    
-    // copy all the elements over to the newly allocated array
-    for (int i = 0; i < numItems; i++){
-        new_data[i] = data[i];
+    // increase the array list capacity
+    resize((capacity * 2) + 2);
+}
+
+/*
+ * name:      resize
+ * purpose:   moves the CharArrayList into an array of a new capacity
+ * arguments: the new capacity, at least numItems
+ * returns:   none
+ * effects:   allocates the new array (none for a capacity of 0), copies
+ *            over elements, and recycles the old array. With the aligned
+ *            layout the capacity is padded first (see setAligned)
+ */
+void CharArrayList::resize(int newCapacity) {
+    newCapacity = paddedCapacity(newCapacity);
+    if (borrowed) {
+        // copy out of memory the list does not own, leaving it alone
+        char *new_data = allocateArray(newCapacity, numItems);
+        std::copy(data, data + numItems, new_data);
+        data = new_data;
+        borrowed = false;
+    } else {
+        // the allocator copies the elements over (or remaps large arrays)
+        // and recycles the old array
+        data = CharArrayAllocator::reallocate(data, capacity, newCapacity,
+                                              numItems, tag);
+        if (aligned and newCapacity > numItems) {
+            std::memset(data + numItems, 0, newCapacity - numItems);
+        }
     }
+    capacity = newCapacity;
+    generation++;
+}
 
-    // deallocate the old array memory and reassign the array pointer
-    delete [] data;
-    data = new_data;
+/*
+ * name:      allocateArray
+ * purpose:   gets a new array for the CharArrayList
+ * arguments: its capacity, and how many chars at the front the caller
+ *            is about to fill in
+ * returns:   the array, charged to the list's tag
+ * effects:   with the aligned layout the rest of the array is zeroed, so
+ *            every char of an aligned array can be read
+ */
+char *CharArrayList::allocateArray(int newCapacity, int used) {
+    char *array = CharArrayAllocator::allocate(newCapacity, tag);
+    if (aligned and newCapacity > used) {
+        std::memset(array + used, 0, newCapacity - used);
+    }
+    return array;
+}
+
+/*
+ * name:      releaseData
+ * purpose:   gives up the array of the CharArrayList
+ * arguments: none
+ * returns:   none
+ * effects:   recycles the array unless it is borrowed; data is left
+ *            dangling for the caller to replace
+ */
+void CharArrayList::releaseData() {
+    if (not borrowed) {
+        CharArrayAllocator::release(data, capacity, tag);
+    }
+    borrowed = false;
+    generation++;
+}
+
+/*
+ * name:      trimIfSparse
+ * purpose:   applies the auto-trim policy after elements are removed
+ * arguments: none
+ * returns:   none
+ * effects:   if auto-trim is on and less than trimThreshold of a large
+ *            enough array is in use, shrinks the capacity to what expand
+ *            would have grown numItems to. That leaves the array about half
+ *            full, well clear of both the trim and the expand points, so
+ *            alternating pushes and pops cannot make it thrash
+ */
+void CharArrayList::trimIfSparse() {
+    if (trimThreshold > 0 and capacity > MIN_TRIM_CAPACITY and
+        numItems < trimThreshold * capacity) {
+        resize((numItems * 2) + 2);
+    }
 }
 
 /*
@@ -353,17 +526,16 @@ void CharArrayList::insertAt(char c, int index) {
     if (capacity <= numItems) {
         expand();
     }
+    contentsChanged();
 
     // add the given element at the given index and shift all elements behind
     // it back one space
-    char temp1 = c;
-    char temp2;
-    for (int i = index; i <= numItems; i++) {
-        temp2 = data[i];
-        data[i] = temp1;
-        temp1 = temp2;
-    }
+    ArrayList<char>::openGap(data, numItems, index);
+    data[index] = c;
     numItems++;
+    if (codePoints != nullptr) {
+        charInserted(index);
+    }
 }
 
 /*
@@ -398,8 +570,14 @@ void CharArrayList::popFromBack() {
     }
 
     // remove the last element of the array list
+    contentsChanged();
     numItems--;
+    char c = data[numItems];
     data[numItems] = 0;
+    if (codePoints != nullptr) {
+        charRemoved(numItems, c);
+    }
+    trimIfSparse();
 }
 
 /*
@@ -417,15 +595,15 @@ void CharArrayList::popFromFront() {
 
     // remove the first element of the array list and shift all other elements
     // back one place
+    contentsChanged();
+    char c = data[0];
+    ArrayList<char>::closeGap(data, numItems, 0);
     numItems--;
-    char temp1 = data[numItems];
     data[numItems] = 0;
-    char temp2;
-    for (int i = numItems - 1; i > -1; i--) {
-        temp2 = data[i];
-        data[i] = temp1;
-        temp1 = temp2;
+    if (codePoints != nullptr) {
+        charRemoved(0, c);
     }
+    trimIfSparse();
 }
 
 /*
@@ -445,33 +623,15 @@ void CharArrayList::removeAt(int index) {
 
     // remove the element at the given index and shift all elements behind
     // it one place forward
+    contentsChanged();
+    char c = data[index];
+    ArrayList<char>::closeGap(data, numItems, index);
     numItems--;
-    char temp1 = data[numItems];
     data[numItems] = 0;
-    char temp2;
-    for (int i = numItems - 1; i >= index; i--) {
-        temp2 = data[i];
-        data[i] = temp1;
-        temp1 = temp2;
+    if (codePoints != nullptr) {
+        charRemoved(index, c);
     }
-}
-
-/*
- * name:      replaceAt
- * purpose:   replace the element at the given index in the CharArrayList
- * arguments: the element being added
- * returns:   error message if the index is out of range
- * effects:   replaces given element in the CharArrayList
- */
-void CharArrayList::replaceAt(char c, int index) {
-    // if the index is out of range of the CharArrayList, throw an error 
-    // message
-    if (index >= numItems or index < 0){
-        throw std::range_error( "index (" + std::to_string(index) + 
-        ") not in range [0.." + std::to_string(numItems) + ")" );
-    }
-    // replace the element at the given index
-    data[index] = c;
+    trimIfSparse();
 }
 
 /*
@@ -482,13 +642,39 @@ void CharArrayList::replaceAt(char c, int index) {
  * effects:   concatenates the given CharArrayList on the end of the original
  */
 void CharArrayList::concatenate(CharArrayList *other) {
-    // Create a temp CharArrayList var to store the list being added
-    CharArrayList temp = *other;
+    appendChars(other->data, other->size());
+}
+
+/*
+ * name:      appendChars
+ * purpose:   adds a run of chars to the end of the CharArrayList
+ * arguments: the chars and how many there are; they may be chars of this
+ *            list (when a list is concatenated with itself)
+ * returns:   none
+ * effects:   makes room once, growing at least as fast as expand would,
+ *            so appending n chars a piece at a time is O(n) amortized
+ */
+void CharArrayList::appendChars(const char *chars, int size) {
+    if (size == 0) {
+        return;
+    }
 
-    // Add each element of the provided list at the end of the original list
-    for (int i = 0; i < temp.size(); i++) {
-        pushAtBack(temp.elementAt(i));
+    // find chars of this list again by their index if the array moves
+    std::less<const char *> before;
+    bool own = data != nullptr and not before(chars, data) and
+               before(chars, data + numItems);
+    long offset = own ? chars - data : 0;
+    if (numItems + size > capacity) {
+        resize(std::max(numItems + size, (capacity * 2) + 2));
     }
+    contentsChanged();
+    if (own) {
+        chars = data + offset;
+    }
+
+    std::copy(chars, chars + size, data + numItems);
+    numItems += size;
+    reindexFrom(numItems - size);
 }
 
 
@@ -500,16 +686,1730 @@ void CharArrayList::concatenate(CharArrayList *other) {
  * effects:   reduces the CharArrayList memory usage to the bare minimum
  */
 void CharArrayList::shrink() {
-    // allocate space on the heap for a new array, exactly the size of the
-    // array list
-    char *temp = new char[numItems];
+    // move into an array exactly the size of the array list; an empty list
+    // gives up its array entirely
+    if (capacity != paddedCapacity(numItems)) {
+        resize(numItems);
+    }
+}
 
-    // copy all the elements of the array list onto this new array
-    for (int i = 0; i < numItems; i++) {
-        temp[i] = data[i];
+/*
+ * name:      setAutoTrim
+ * purpose:   turns automatic shrinking on or off
+ * arguments: the fraction of the capacity below which removing elements
+ *            shrinks the array, in (0, 0.5), or 0 to turn auto-trim off
+ * returns:   error message if the threshold is out of range
+ * effects:   also adds the CharArrayList to (or removes it from) the lists
+ *            trimmed by trimAll. The setting is not copied by the copy
+ *            constructor or assignment operator
+ */
+void CharArrayList::setAutoTrim(double threshold) {
+    // below one half, so a trimmed list is never right back at the trim
+    // point
+    if (threshold < 0 or threshold >= 0.5) {
+        throw std::range_error("auto-trim threshold not in range [0..0.5)");
+    }
+
+    std::lock_guard<std::mutex> guard(autoTrimLock);
+    if (threshold > 0) {
+        autoTrimLists.insert(this);
+    } else {
+        autoTrimLists.erase(this);
+    }
+    trimThreshold = threshold;
+}
+
+/*
+ * name:      setAligned
+ * purpose:   turns the cache line aligned layout on or off
+ * arguments: true for the aligned layout
+ * returns:   none
+ * effects:   with it on, every array the list allocates starts on a
+ *            CharArrayAllocator::ALIGNMENT byte boundary and its capacity
+ *            is a multiple of ALIGNMENT, with the chars past the end zeroed
+ *            when allocated. Turning it on moves a packed or wrapped array
+ *            into an aligned one right away; turning it off leaves the array
+ *            where it is until the list next reallocates
+ */
+void CharArrayList::setAligned(bool on) {
+    aligned = on;
+    if (on and capacity > 0 and
+        (borrowed or capacity % CharArrayAllocator::ALIGNMENT != 0)) {
+        resize(capacity);
+    }
+}
+
+/*
+ * name:      isAligned
+ * purpose:   determines if the list uses the aligned layout
+ * arguments: none
+ * returns:   true if setAligned(true) is in effect
+ * effects:   none
+ */
+bool CharArrayList::isAligned() const {
+    return aligned;
+}
+
+/*
+ * name:      paddedCapacity
+ * purpose:   finds the capacity the list actually uses for an array
+ * arguments: the number of chars the array must hold
+ * returns:   that number, rounded up to a multiple of
+ *            CharArrayAllocator::ALIGNMENT with the aligned layout
+ * effects:   none
+ */
+int CharArrayList::paddedCapacity(int size) const {
+    return aligned ? CharArrayAllocator::alignedCapacity(size) : size;
+}
+
+/*
+ * name:      trimAll
+ * purpose:   releases unused capacity of every auto-trimmed CharArrayList,
+ *            e.g. in response to a memory pressure signal
+ * arguments: none
+ * returns:   the number of bytes released
+ * effects:   shrinks every CharArrayList with auto-trim on, which moves
+ *            their arrays and so invalidates views of them. Only safe at a
+ *            quiet point: no other thread may be using those lists and no
+ *            views of them may be in use. Run as a CharArrayAllocator trim
+ *            callback it would break both rules, so there it does nothing
+ */
+long CharArrayList::trimAll() {
+    if (CharArrayAllocator::inTrimCallback()) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> guard(autoTrimLock);
+    long released = 0;
+    for (CharArrayList *list : autoTrimLists) {
+        int before = list->capacity;
+        list->shrink();
+        released += before - list->capacity;
+    }
+    return released;
+}
+
+/*
+ * name:      trimmableSlack
+ * purpose:   measures the unused capacity trimAll could release
+ * arguments: none
+ * returns:   the capacity not holding elements, summed over every
+ *            CharArrayList with auto-trim on
+ * effects:   none. No other thread may be changing those lists
+ */
+long CharArrayList::trimmableSlack() {
+    std::lock_guard<std::mutex> guard(autoTrimLock);
+    long slack = 0;
+    for (CharArrayList *list : autoTrimLists) {
+        slack += list->capacity - list->paddedCapacity(list->numItems);
+    }
+    return slack;
+}
+
+/*
+ * name:      applyEdits
+ * purpose:   applies a batch of inserts, removes and replaces in one pass
+ * arguments: an array of Edits and the number of Edits in it
+ * returns:   error message if numEdits is negative or any edit index is
+ *            out of range
+ * effects:   rebuilds the CharArrayList with every edit applied. Indexes
+ *            refer to the list before the batch; inserts sharing an index
+ *            keep their batch order, a removed element ignores any replace
+ *            at the same index. Nothing is changed if an index is bad.
+ */
+void CharArrayList::applyEdits(const Edit edits[], int numEdits) {
+    if (numEdits < 0) {
+        throw std::range_error("number of edits (" +
+                               std::to_string(numEdits) +
+                               ") must not be negative");
+    }
+
+    // check every index up front so a bad batch leaves the list untouched,
+    // using the same messages as insertAt, removeAt and replaceAt
+    for (int i = 0; i < numEdits; i++) {
+        int index = edits[i].index;
+        if (edits[i].kind == INSERT) {
+            if (index > numItems or index < 0) {
+                throw std::range_error( "index (" + std::to_string(index) +
+                ") not in range [0.." + std::to_string(numItems) + "]" );
+            }
+        } else if (index >= numItems or index < 0) {
+            throw std::range_error( "index (" + std::to_string(index) +
+            ") not in range [0.." + std::to_string(numItems) + ")" );
+        }
+    }
+
+    // order the edits by position, keeping batch order for equal positions
+    std::vector<Edit> sorted(edits, edits + numEdits);
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const Edit &a, const Edit &b) {
+                         return a.index < b.index;
+                     });
+
+    // work out the final size so the new array is allocated exactly once
+    int newSize = numItems;
+    for (int i = 0; i < numEdits; ) {
+        int index = sorted[i].index;
+        bool removed = false;
+        for (; i < numEdits and sorted[i].index == index; i++) {
+            if (sorted[i].kind == INSERT) {
+                newSize++;
+            } else if (sorted[i].kind == REMOVE) {
+                removed = true;
+            }
+        }
+        if (removed) {
+            newSize--;
+        }
+    }
+
+    // merge the untouched runs of the old array with the edits
+    if (numEdits > 0) {
+        contentsChanged();
+    }
+    int newCapacity = paddedCapacity(newSize);
+    char *new_data = allocateArray(newCapacity, newSize);
+    int out = 0;
+    int next = 0;   // next element of the old array not yet copied
+    int i = 0;
+    while (i < numEdits) {
+        int index = sorted[i].index;
+        out = std::copy(data + next, data + index, new_data + out) - new_data;
+        next = index;
+
+        // handle every edit at this position
+        bool removed = false;
+        bool replaced = false;
+        char replacement = 0;
+        for (; i < numEdits and sorted[i].index == index; i++) {
+            if (sorted[i].kind == INSERT) {
+                new_data[out++] = sorted[i].c;
+            } else if (sorted[i].kind == REMOVE) {
+                removed = true;
+            } else {
+                replaced = true;
+                replacement = sorted[i].c;
+            }
+        }
+
+        // then the old element itself, if the edits touched it
+        if (removed) {
+            next++;
+        } else if (replaced) {
+            new_data[out++] = replacement;
+            next++;
+        }
+    }
+    std::copy(data + next, data + numItems, new_data + out);
+
+    // deallocate the old array and reassign the array pointer
+    releaseData();
+    data = new_data;
+    numItems = newSize;
+    capacity = newCapacity;
+    if (numEdits > 0) {
+        reindexFrom(sorted[0].index);
+    }
+}
+
+/*
+ * name:      search
+ * purpose:   finds the first occurrence of a run of chars in another
+ * arguments: the chars to search and how many there are, the chars to look
+ *            for and how many there are, and the index to start from
+ * returns:   index of the first match at or after start, or -1 if none
+ * effects:   none
+ */
+int CharArrayList::search(const char *text, int textSize,
+                          const char *pattern, int patternSize, int start) {
+    if (patternSize == 0) {
+        return start;
+    }
+    if (patternSize > textSize - start) {
+        return -1;
+    }
+
+    int lastStart = textSize - patternSize;
+    if (patternSize < 16) {
+        // short patterns: let memchr (vectorized in libc) find candidates
+        // for the first char, check the last char, then the rest
+        char firstChar = pattern[0];
+        char lastChar = pattern[patternSize - 1];
+        int i = start;
+        while (i <= lastStart) {
+            const void *hit = std::memchr(text + i, firstChar,
+                                          lastStart - i + 1);
+            if (hit == nullptr) {
+                return -1;
+            }
+            i = static_cast<const char *>(hit) - text;
+            if (text[i + patternSize - 1] == lastChar and
+                std::memcmp(text + i, pattern, patternSize) == 0) {
+                return i;
+            }
+            i++;
+        }
+        return -1;
+    }
+
+    // longer patterns: Boyer-Moore-Horspool, skipping on the char under
+    // the last position of the window
+    int skip[256];
+    for (int c = 0; c < 256; c++) {
+        skip[c] = patternSize;
+    }
+    for (int j = 0; j < patternSize - 1; j++) {
+        skip[static_cast<unsigned char>(pattern[j])] = patternSize - 1 - j;
+    }
+    char lastChar = pattern[patternSize - 1];
+    int i = start;
+    while (i <= lastStart) {
+        char c = text[i + patternSize - 1];
+        if (c == lastChar and
+            std::memcmp(text + i, pattern, patternSize - 1) == 0) {
+            return i;
+        }
+        i += skip[static_cast<unsigned char>(c)];
+    }
+    return -1;
+}
+
+/*
+ * name:      findSubsequence
+ * purpose:   finds where another CharArrayList appears inside this one
+ * arguments: the CharArrayList to look for and the index to start from
+ * returns:   index of the first match at or after start, or -1 if there is
+ *            none. An empty pattern matches at start. Error message if
+ *            start is out of range
+ * effects:   none
+ */
+int CharArrayList::findSubsequence(const CharArrayList &pattern,
+                                   int start) const {
+    if (start > numItems or start < 0) {
+        throw std::range_error( "index (" + std::to_string(start) +
+        ") not in range [0.." + std::to_string(numItems) + "]" );
+    }
+    return search(data, numItems, pattern.data, pattern.numItems, start);
+}
+
+/*
+ * name:      countSubsequence
+ * purpose:   counts how many times another CharArrayList appears in this one
+ * arguments: the CharArrayList to look for
+ * returns:   number of non-overlapping matches, 0 for an empty pattern
+ * effects:   none
+ */
+int CharArrayList::countSubsequence(const CharArrayList &pattern) const {
+    if (pattern.isEmpty()) {
+        return 0;
+    }
+
+    int count = 0;
+    int i = search(data, numItems, pattern.data, pattern.numItems, 0);
+    while (i != -1) {
+        count++;
+        i = search(data, numItems, pattern.data, pattern.numItems,
+                   i + pattern.numItems);
+    }
+    return count;
+}
+
+/*
+ * name:      replaceAll
+ * purpose:   replaces every occurrence of a pattern with a replacement
+ * arguments: the CharArrayList to look for and the one to put in its place
+ * returns:   number of non-overlapping matches replaced
+ * effects:   rebuilds the CharArrayList in one exactly sized array. An empty
+ *            pattern replaces nothing
+ */
+int CharArrayList::replaceAll(const CharArrayList &pattern,
+                              const CharArrayList &replacement) {
+    if (pattern.isEmpty()) {
+        return 0;
+    }
+
+    // find every match first so the new array can be sized exactly
+    std::vector<int> matches;
+    int i = search(data, numItems, pattern.data, pattern.numItems, 0);
+    while (i != -1) {
+        matches.push_back(i);
+        i = search(data, numItems, pattern.data, pattern.numItems,
+                   i + pattern.numItems);
+    }
+    if (matches.empty()) {
+        return 0;
+    }
+
+    // copy the runs between matches and the replacement for each match
+    contentsChanged();
+    int count = matches.size();
+    int newSize = numItems +
+                  count * (replacement.numItems - pattern.numItems);
+    int newCapacity = paddedCapacity(newSize);
+    char *new_data = allocateArray(newCapacity, newSize);
+    char *out = new_data;
+    int next = 0;
+    for (int j = 0; j < count; j++) {
+        out = std::copy(data + next, data + matches[j], out);
+        out = std::copy(replacement.data,
+                        replacement.data + replacement.numItems, out);
+        next = matches[j] + pattern.numItems;
+    }
+    std::copy(data + next, data + numItems, out);
+
+    // deallocate the old array and reassign the array pointer
+    releaseData();
+    data = new_data;
+    numItems = newSize;
+    capacity = newCapacity;
+    reindexFrom(matches[0]);
+    return count;
+}
+
+/*
+ * name:      mapChars
+ * purpose:   replaces every char in a run with a function of itself
+ * arguments: the chars, how many there are, and the function, which is
+ *            given each char as an unsigned char
+ * returns:   none
+ * effects:   works a block at a time with a prefetch hint per block; the
+ *            loop over a block has a fixed length, so the compiler can
+ *            vectorize it without a tail
+ */
+template <typename Map>
+static void mapChars(char *chars, int size, Map map) {
+    int i = 0;
+    for (; i + BLOCK <= size; i += BLOCK) {
+        PREFETCH(chars + i + PREFETCH_DISTANCE);
+        for (int j = i; j < i + BLOCK; j++) {
+            chars[j] = map(static_cast<unsigned char>(chars[j]));
+        }
     }
-    // deallocate the heap memory of the old array list
-    delete [] data;
-    data = temp;
-    capacity = numItems;
-}
\ No newline at end of file
+    for (; i < size; i++) {
+        chars[i] = map(static_cast<unsigned char>(chars[i]));
+    }
+}
+
+/*
+ * name:      mappedSize
+ * purpose:   finds how many chars an in place map should go through
+ * arguments: none
+ * returns:   numItems, or with the aligned layout numItems rounded up to
+ *            whole blocks; the padding is part of the array and is always
+ *            initialized, so changing it does no harm and leaves no tail
+ * effects:   none
+ */
+int CharArrayList::mappedSize() const {
+    return aligned and capacity % BLOCK == 0 ? paddedCapacity(numItems)
+                                             : numItems;
+}
+
+/*
+ * name:      toUpper
+ * purpose:   converts every ASCII lowercase letter to uppercase
+ * arguments: none
+ * returns:   none
+ * effects:   changes 'a'..'z' to 'A'..'Z', leaves every other char alone
+ */
+void CharArrayList::toUpper() {
+    // letters stay letters, so the code point index needs no update
+    contentsChanged();
+
+    // no branches in the map, so the compiler can vectorize it
+    mapChars(data, mappedSize(), [](unsigned char c) -> char {
+        return c - 32 * (static_cast<unsigned char>(c - 'a') < 26);
+    });
+}
+
+/*
+ * name:      toLower
+ * purpose:   converts every ASCII uppercase letter to lowercase
+ * arguments: none
+ * returns:   none
+ * effects:   changes 'A'..'Z' to 'a'..'z', leaves every other char alone
+ */
+void CharArrayList::toLower() {
+    contentsChanged();
+    mapChars(data, mappedSize(), [](unsigned char c) -> char {
+        return c + 32 * (static_cast<unsigned char>(c - 'A') < 26);
+    });
+}
+
+/*
+ * name:      translate
+ * purpose:   remaps every char through a lookup table
+ * arguments: a 256 entry table indexed by the unsigned value of each char
+ * returns:   none
+ * effects:   replaces each char c with table[c]
+ */
+void CharArrayList::translate(const uint8_t table[256]) {
+    contentsChanged();
+    mapChars(data, mappedSize(), [table](unsigned char c) -> char {
+        return table[c];
+    });
+    reindexFrom(0);
+}
+
+/*
+ * name:      countWhere
+ * purpose:   counts the chars in a run that pass a test
+ * arguments: the chars, how many there are, and the test, which is given
+ *            each char as an unsigned char
+ * returns:   the number of chars that pass
+ * effects:   works a block at a time like mapChars
+ */
+template <typename Test>
+static int countWhere(const char *chars, int size, Test test) {
+    int count = 0;
+    int i = 0;
+    for (; i + BLOCK <= size; i += BLOCK) {
+        PREFETCH(chars + i + PREFETCH_DISTANCE);
+        for (int j = i; j < i + BLOCK; j++) {
+            count += test(static_cast<unsigned char>(chars[j]));
+        }
+    }
+    for (; i < size; i++) {
+        count += test(static_cast<unsigned char>(chars[i]));
+    }
+    return count;
+}
+
+/*
+ * name:      countIf
+ * purpose:   counts the chars that belong to an ASCII character class
+ * arguments: the class to count (DIGIT, WHITESPACE or ALPHA)
+ * returns:   the number of chars in the class
+ * effects:   none
+ */
+int CharArrayList::countIf(CharClass charClass) const {
+    // one branch free test per class, so each one can be vectorized
+    if (charClass == DIGIT) {
+        return countWhere(data, numItems, [](unsigned char c) {
+            return static_cast<unsigned char>(c - '0') < 10;
+        });
+    } else if (charClass == WHITESPACE) {
+        // ' ', '\t', '\n', '\v', '\f' and '\r'
+        return countWhere(data, numItems, [](unsigned char c) {
+            return (c == ' ') | (static_cast<unsigned char>(c - '\t') < 5);
+        });
+    }
+    return countWhere(data, numItems, [](unsigned char c) {
+        return static_cast<unsigned char>((c | 32) - 'a') < 26;
+    });
+}
+
+/*
+ * name:      isValidUtf8
+ * purpose:   determines if the CharArrayList holds well formed UTF-8
+ * arguments: none
+ * returns:   true if every char is part of a valid UTF-8 sequence (no
+ *            overlong forms, surrogates or code points past U+10FFFF)
+ * effects:   none
+ */
+bool CharArrayList::isValidUtf8() const {
+    int i = 0;
+    while (i < numItems) {
+        // skip ASCII eight chars at a time
+        if (i + 8 <= numItems) {
+            uint64_t block;
+            std::memcpy(&block, data + i, 8);
+            if ((block & 0x8080808080808080ULL) == 0) {
+                i += 8;
+                continue;
+            }
+        }
+
+        unsigned char c = data[i];
+        int length;
+        unsigned char low = 0x80;   // allowed range of the second char
+        unsigned char high = 0xBF;
+        if (c < 0x80) {
+            i++;
+            continue;
+        } else if (c >= 0xC2 and c <= 0xDF) {
+            length = 2;
+        } else if (c >= 0xE0 and c <= 0xEF) {
+            length = 3;
+            if (c == 0xE0) {
+                low = 0xA0;     // overlong
+            } else if (c == 0xED) {
+                high = 0x9F;    // surrogates
+            }
+        } else if (c >= 0xF0 and c <= 0xF4) {
+            length = 4;
+            if (c == 0xF0) {
+                low = 0x90;     // overlong
+            } else if (c == 0xF4) {
+                high = 0x8F;    // past U+10FFFF
+            }
+        } else {
+            return false;
+        }
+
+        if (i + length > numItems) {
+            return false;
+        }
+        unsigned char second = data[i + 1];
+        if (second < low or second > high) {
+            return false;
+        }
+        for (int j = 2; j < length; j++) {
+            if ((static_cast<unsigned char>(data[i + j]) & 0xC0) != 0x80) {
+                return false;
+            }
+        }
+        i += length;
+    }
+    return true;
+}
+
+/*
+ * name:      codePointCount
+ * purpose:   determines the number of UTF-8 code points in the CharArrayList
+ * arguments: none
+ * returns:   the number of chars that are not UTF-8 continuation chars
+ * effects:   none
+ */
+int CharArrayList::codePointCount() const {
+    // branch free so the compiler can vectorize it
+    return countWhere(data, numItems, [](unsigned char c) {
+        return (c & 0xC0) != 0x80;
+    });
+}
+
+/*
+ * name:      enableCodePointIndex
+ * purpose:   turns on the sampled code point index
+ * arguments: how many code points apart the samples are
+ * returns:   error message if every is not positive
+ * effects:   builds the index, at the cost of one int per sample. From
+ *            then on codePointOffset and codePointRange take O(every)
+ *            time, and the functions that change the list keep the index
+ *            up to date: O(size() / every) for a single char, and a rescan
+ *            from the first changed char for the others
+ */
+void CharArrayList::enableCodePointIndex(int every) {
+    if (every <= 0) {
+        throw std::range_error("sample interval must be positive");
+    }
+    if (codePoints == nullptr) {
+        codePoints = new CodePointIndex;
+    }
+    codePoints->every = every;
+    codePoints->samples.clear();
+    reindexFrom(0);
+}
+
+/*
+ * name:      disableCodePointIndex
+ * purpose:   turns off the sampled code point index
+ * arguments: none
+ * returns:   none
+ * effects:   frees the index; code point lookups scan from the start
+ */
+void CharArrayList::disableCodePointIndex() {
+    delete codePoints;
+    codePoints = nullptr;
+}
+
+/*
+ * name:      codePointOffset
+ * purpose:   finds where a code point starts
+ * arguments: the number of the code point, counting from 0
+ * returns:   index of the first char of code point n (size() if n is the
+ *            number of code points), or an error if n is out of range
+ * effects:   none; safe to call from several threads at once
+ */
+int CharArrayList::codePointOffset(int n) const {
+    if (n < 0) {
+        throw std::range_error( "index (" + std::to_string(n) +
+        ") not in range [0.." + std::to_string(codePointCount()) + "]" );
+    }
+
+    // start from the nearest sample at or before n if the index is on;
+    // past the last sample there are fewer than every code points left
+    int i = 0;
+    int count = 0;
+    if (codePoints != nullptr and not codePoints->samples.empty()) {
+        int every = codePoints->every;
+        int last = codePoints->samples.size() - 1;
+        int nearest = std::min(n / every, last);
+        i = codePoints->samples[nearest];
+        count = nearest * every;
+    }
+    for (; i < numItems; i++) {
+        if (not isCodePointStart(data[i])) {
+            continue;
+        }
+        if (count == n) {
+            return i;
+        }
+        count++;
+    }
+    if (count == n) {
+        return numItems;
+    }
+    throw std::range_error( "index (" + std::to_string(n) +
+    ") not in range [0.." + std::to_string(codePointCount()) + "]" );
+}
+
+/*
+ * name:      charInserted
+ * purpose:   updates the code point index after a char was inserted
+ * arguments: the index the char was inserted at
+ * returns:   none
+ * effects:   moves the samples after the char back one place. If the char
+ *            starts a code point, every later code point is numbered one
+ *            higher, so each of those samples moves to the code point
+ *            before the one it was on, and a sample is added at the end
+ *            when the count reaches the next multiple of every
+ */
+void CharArrayList::charInserted(int index) {
+    std::vector<int> &samples = codePoints->samples;
+    bool start = isCodePointStart(data[index]);
+    auto first = std::lower_bound(samples.begin(), samples.end(), index);
+    for (auto sample = first; sample != samples.end(); ++sample) {
+        int i = *sample + 1;
+        if (start) {
+            // the inserted char is a start at or before i, so this stops
+            do {
+                i--;
+            } while (not isCodePointStart(data[i]));
+        }
+        *sample = i;
+    }
+    if (start) {
+        codePointAdded();
+    }
+}
+
+/*
+ * name:      charRemoved
+ * purpose:   updates the code point index after a char was removed
+ * arguments: the index the char was removed from, and the char
+ * returns:   none
+ * effects:   moves the samples after the char forward one place. If the
+ *            char started a code point, every later code point is numbered
+ *            one lower, so each of those samples moves to the code point
+ *            after the one it was on, and the last sample goes if its code
+ *            point no longer exists
+ */
+void CharArrayList::charRemoved(int index, char c) {
+    std::vector<int> &samples = codePoints->samples;
+    auto first = std::lower_bound(samples.begin(), samples.end(), index);
+    if (not isCodePointStart(c)) {
+        for (auto sample = first; sample != samples.end(); ++sample) {
+            (*sample)--;
+        }
+        return;
+    }
+    // the sample on the removed char moves to the next start at index,
+    // a later one at i to the next start after i - 1
+    for (auto sample = first; sample != samples.end(); ++sample) {
+        int i = *sample;
+        while (i < numItems and not isCodePointStart(data[i])) {
+            i++;
+        }
+        *sample = i;
+    }
+    codePointRemoved();
+}
+
+/*
+ * name:      charReplaced
+ * purpose:   updates the code point index after a char was replaced
+ * arguments: the index of the char and the char it replaced
+ * returns:   none
+ * effects:   nothing changes unless the char started a code point and its
+ *            replacement does not, or the other way around; then the later
+ *            samples move as they do for charRemoved or charInserted
+ */
+void CharArrayList::charReplaced(int index, char old) {
+    bool wasStart = isCodePointStart(old);
+    if (wasStart == isCodePointStart(data[index])) {
+        return;
+    }
+    std::vector<int> &samples = codePoints->samples;
+    auto first = std::lower_bound(samples.begin(), samples.end(), index);
+    for (auto sample = first; sample != samples.end(); ++sample) {
+        int i = *sample;
+        if (wasStart) {
+            // on to the start of the next code point
+            do {
+                i++;
+            } while (i < numItems and not isCodePointStart(data[i]));
+        } else {
+            // back to the start of the one before, at index or later
+            do {
+                i--;
+            } while (not isCodePointStart(data[i]));
+        }
+        *sample = i;
+    }
+    if (wasStart) {
+        codePointRemoved();
+    } else {
+        codePointAdded();
+    }
+}
+
+/*
+ * name:      codePointAdded
+ * purpose:   counts a code point added to an indexed list
+ * arguments: none
+ * returns:   none
+ * effects:   samples the last code point if its number is a multiple of
+ *            every; the samples before it must already be up to date
+ */
+void CharArrayList::codePointAdded() {
+    CodePointIndex &index = *codePoints;
+    if (index.count % index.every == 0) {
+        int i = numItems - 1;
+        while (not isCodePointStart(data[i])) {
+            i--;
+        }
+        index.samples.push_back(i);
+    }
+    index.count++;
+}
+
+/*
+ * name:      codePointRemoved
+ * purpose:   counts a code point removed from an indexed list
+ * arguments: none
+ * returns:   none
+ * effects:   drops the last sample if its code point no longer exists
+ */
+void CharArrayList::codePointRemoved() {
+    CodePointIndex &index = *codePoints;
+    index.count--;
+    if (index.count % index.every == 0) {
+        index.samples.pop_back();
+    }
+}
+
+/*
+ * name:      reindexFrom
+ * purpose:   updates the code point index after a change of many chars
+ * arguments: the index of the first char that may have changed
+ * returns:   none
+ * effects:   keeps the samples before the index, since whether a char
+ *            starts a code point depends only on the char itself, and
+ *            rescans the rest of the list for new ones. Does nothing when
+ *            the index is off
+ */
+void CharArrayList::reindexFrom(int index) {
+    if (codePoints == nullptr) {
+        return;
+    }
+    std::vector<int> &samples = codePoints->samples;
+    int every = codePoints->every;
+    samples.erase(std::lower_bound(samples.begin(), samples.end(), index),
+                  samples.end());
+
+    // count from the last sample kept
+    int i = samples.empty() ? 0 : samples.back();
+    int count = samples.empty() ? 0 : (samples.size() - 1) * every;
+    for (; i < numItems; i++) {
+        if (isCodePointStart(data[i])) {
+            if (count % every == 0 and
+                count / every == static_cast<int>(samples.size())) {
+                samples.push_back(i);
+            }
+            count++;
+        }
+    }
+    codePoints->count = count;
+}
+
+/*
+ * name:      codePointRange
+ * purpose:   copies out a range of code points
+ * arguments: number of the first code point and one past the last one
+ * returns:   a CharArrayList holding code points [begin, end), or an error
+ *            if the range is out of order or out of range
+ * effects:   may extend the code point index
+ */
+CharArrayList CharArrayList::codePointRange(int begin, int end) const {
+    if (end < begin) {
+        throw std::range_error( "index (" + std::to_string(end) +
+        ") not in range [" + std::to_string(begin) + ".." +
+        std::to_string(codePointCount()) + "]" );
+    }
+    int first = codePointOffset(begin);
+    int last = codePointOffset(end);
+    return CharArrayList(data + first, last - first);
+}
+
+/*
+ * name:      operator==
+ * purpose:   determines if two CharArrayLists hold the same chars
+ * arguments: address of the other CharArrayList
+ * returns:   true if both lists have the same size and elements
+ * effects:   none
+ */
+bool CharArrayList::operator==(const CharArrayList &other) const {
+    if (numItems != other.numItems) {
+        return false;
+    }
+    // two cached hashes that differ settle it without reading the arrays
+    if (hashValid.load(std::memory_order_acquire) and
+        other.hashValid.load(std::memory_order_acquire) and
+        cachedHash.load(std::memory_order_relaxed) !=
+        other.cachedHash.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    return numItems == 0 or std::memcmp(data, other.data, numItems) == 0;
+}
+
+/*
+ * name:      operator<=>
+ * purpose:   orders two CharArrayLists
+ * arguments: address of the other CharArrayList
+ * returns:   the lexicographical ordering of the two lists, comparing chars
+ *            as unsigned values; a list sorts before any longer list it is
+ *            a prefix of
+ * effects:   none
+ */
+std::strong_ordering CharArrayList::operator<=>(
+    const CharArrayList &other) const {
+    int shared = std::min(numItems, other.numItems);
+    int result = shared == 0 ? 0 : std::memcmp(data, other.data, shared);
+    if (result != 0) {
+        return result < 0 ? std::strong_ordering::less
+                          : std::strong_ordering::greater;
+    }
+    return numItems <=> other.numItems;
+}
+
+/*
+ * name:      hash
+ * purpose:   computes a hash of the contents of the CharArrayList
+ * arguments: none
+ * returns:   the 64-bit xxHash (XXH64, seed 0) of the elements
+ * effects:   caches the hash until the list is next changed. Safe to call
+ *            from several threads at once
+ */
+uint64_t CharArrayList::hash() const {
+    if (hashValid.load(std::memory_order_acquire)) {
+        return cachedHash.load(std::memory_order_relaxed);
+    }
+    // another thread may be doing the same; it stores the same value
+    uint64_t value = hashChars(data, numItems);
+    cachedHash.store(value, std::memory_order_relaxed);
+    hashValid.store(true, std::memory_order_release);
+    return value;
+}
+
+/*
+ * name:      hashChars
+ * purpose:   computes the hash used by hash() for any run of chars
+ * arguments: the chars and how many there are
+ * returns:   the 64-bit xxHash (XXH64, seed 0) of the chars
+ * effects:   none
+ */
+uint64_t CharArrayList::hashChars(const char *chars, int size) {
+    const uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+    const uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+    const uint64_t prime3 = 0x165667B19E3779F9ULL;
+    const uint64_t prime4 = 0x85EBCA77C2B2AE63ULL;
+    const uint64_t prime5 = 0x27D4EB2F165667C5ULL;
+    auto rotl = [](uint64_t x, int r) {
+        return (x << r) | (x >> (64 - r));
+    };
+    auto round = [&](uint64_t acc, uint64_t input) {
+        acc += input * prime2;
+        return rotl(acc, 31) * prime1;
+    };
+    auto read64 = [chars](int i) {
+        uint64_t v;
+        std::memcpy(&v, chars + i, 8);
+        return v;
+    };
+
+    int i = 0;
+    uint64_t h;
+    if (size >= 32) {
+        // four independent lanes over 32 char stripes
+        uint64_t v1 = prime1 + prime2;
+        uint64_t v2 = prime2;
+        uint64_t v3 = 0;
+        uint64_t v4 = -prime1;
+        for (; i + 32 <= size; i += 32) {
+            PREFETCH(chars + i + PREFETCH_DISTANCE);
+            v1 = round(v1, read64(i));
+            v2 = round(v2, read64(i + 8));
+            v3 = round(v3, read64(i + 16));
+            v4 = round(v4, read64(i + 24));
+        }
+        h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+        uint64_t lanes[4] = { v1, v2, v3, v4 };
+        for (int j = 0; j < 4; j++) {
+            h ^= round(0, lanes[j]);
+            h = h * prime1 + prime4;
+        }
+    } else {
+        h = prime5;
+    }
+    h += size;
+
+    // the tail, eight, four and then one char at a time
+    for (; i + 8 <= size; i += 8) {
+        h ^= round(0, read64(i));
+        h = rotl(h, 27) * prime1 + prime4;
+    }
+    if (i + 4 <= size) {
+        uint32_t v;
+        std::memcpy(&v, chars + i, 4);
+        h ^= v * prime1;
+        h = rotl(h, 23) * prime2 + prime3;
+        i += 4;
+    }
+    for (; i < size; i++) {
+        h ^= static_cast<unsigned char>(chars[i]) * prime5;
+        h = rotl(h, 11) * prime1;
+    }
+
+    // final mix
+    h ^= h >> 33;
+    h *= prime2;
+    h ^= h >> 29;
+    h *= prime3;
+    h ^= h >> 32;
+    return h;
+}
+
+/*
+ * Binary format, all integers little endian:
+ *     bytes 0-3    magic "CALB"
+ *     bytes 4-5    format version (1)
+ *     bytes 6-7    flags; bit 0 set when a checksum is present
+ *     bytes 8-15   number of chars
+ *     bytes 16-23  XXH64 of the chars, or 0 without a checksum
+ *     bytes 24-63  zero
+ * then the chars, then zeros up to the next multiple of 64 bytes.
+ */
+static const char SERIAL_MAGIC[4] = { 'C', 'A', 'L', 'B' };
+static const int SERIAL_VERSION = 1;
+static const int SERIAL_CHECKSUM_FLAG = 1;
+
+// write and read an unsigned integer of size bytes, little endian
+static void putLittleEndian(char *out, uint64_t value, int size) {
+    for (int i = 0; i < size; i++) {
+        out[i] = static_cast<char>(value >> (8 * i));
+    }
+}
+
+static uint64_t getLittleEndian(const char *in, int size) {
+    uint64_t value = 0;
+    for (int i = 0; i < size; i++) {
+        value |= static_cast<uint64_t>(static_cast<unsigned char>(in[i]))
+                 << (8 * i);
+    }
+    return value;
+}
+
+// fill in the header for length chars with the given checksum, if any
+static void writeHeader(char *header, int length, bool checksum,
+                        uint64_t hash) {
+    std::memset(header, 0, CharArrayList::SERIAL_HEADER_SIZE);
+    std::memcpy(header, SERIAL_MAGIC, 4);
+    putLittleEndian(header + 4, SERIAL_VERSION, 2);
+    putLittleEndian(header + 6, checksum ? SERIAL_CHECKSUM_FLAG : 0, 2);
+    putLittleEndian(header + 8, length, 8);
+    putLittleEndian(header + 16, checksum ? hash : 0, 8);
+}
+
+/*
+ * name:      serializedSize
+ * purpose:   determines how many bytes serialize writes
+ * arguments: none
+ * returns:   the header size plus the chars padded to a multiple of 64
+ * effects:   none
+ */
+long CharArrayList::serializedSize() const {
+    return SERIAL_HEADER_SIZE + ((numItems + 63L) / 64) * 64;
+}
+
+/*
+ * name:      serialize
+ * purpose:   writes the CharArrayList to memory in the binary format
+ * arguments: where to write, how much room there is, and whether to store
+ *            a checksum of the chars
+ * returns:   the number of bytes written (serializedSize), or an error
+ *            message if there is not enough room
+ * effects:   fills the first serializedSize bytes of the buffer
+ */
+long CharArrayList::serialize(char *buffer, long bufferSize,
+                              bool checksum) const {
+    long total = serializedSize();
+    if (bufferSize < total) {
+        throw std::runtime_error("buffer too small to serialize ArrayList");
+    }
+
+    writeHeader(buffer, numItems, checksum, checksum ? hash() : 0);
+
+    std::copy(data, data + numItems, buffer + SERIAL_HEADER_SIZE);
+    std::memset(buffer + SERIAL_HEADER_SIZE + numItems, 0,
+                total - SERIAL_HEADER_SIZE - numItems);
+    return total;
+}
+
+/*
+ * name:      serialize
+ * purpose:   writes the CharArrayList to a file descriptor in the binary
+ *            format
+ * arguments: the file descriptor and whether to store a checksum
+ * returns:   error message if writing fails
+ * effects:   writes serializedSize bytes with as few system calls as
+ *            possible, straight from the array
+ */
+void CharArrayList::serialize(int fd, bool checksum) const {
+    char header[SERIAL_HEADER_SIZE];
+    char padding[64] = {};
+    writeHeader(header, numItems, checksum, checksum ? hash() : 0);
+
+    struct iovec parts[3];
+    parts[0].iov_base = header;
+    parts[0].iov_len = SERIAL_HEADER_SIZE;
+    parts[1].iov_base = data;
+    parts[1].iov_len = numItems;
+    parts[2].iov_base = padding;
+    parts[2].iov_len = serializedSize() - SERIAL_HEADER_SIZE - numItems;
+
+    // keep going after partial writes
+    int first = 0;
+    while (first < 3) {
+        ssize_t written = writev(fd, parts + first, 3 - first);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("cannot write ArrayList: " +
+                                     std::string(std::strerror(errno)));
+        }
+        while (first < 3 and
+               static_cast<size_t>(written) >= parts[first].iov_len) {
+            written -= parts[first].iov_len;
+            first++;
+        }
+        if (first < 3) {
+            parts[first].iov_base =
+                static_cast<char *>(parts[first].iov_base) + written;
+            parts[first].iov_len -= written;
+        }
+    }
+}
+
+/*
+ * name:      readHeader
+ * purpose:   checks a serialized CharArrayList
+ * arguments: the serialized bytes, how many there are, whether to check
+ *            the checksum, and where to store whether it was checked
+ * returns:   the number of chars, or an error message if the bytes are not
+ *            a complete serialized CharArrayList of a known version, or the
+ *            checksum does not match
+ * effects:   none
+ */
+long CharArrayList::readHeader(const char *buffer, long bufferSize,
+                               bool verify, bool *checked) {
+    if (bufferSize < SERIAL_HEADER_SIZE or
+        std::memcmp(buffer, SERIAL_MAGIC, 4) != 0) {
+        throw std::runtime_error("not a serialized ArrayList");
+    }
+    if (getLittleEndian(buffer + 4, 2) != SERIAL_VERSION) {
+        throw std::runtime_error("unsupported serialized ArrayList version");
+    }
+    uint64_t length = getLittleEndian(buffer + 8, 8);
+    if (length > static_cast<uint64_t>(bufferSize - SERIAL_HEADER_SIZE) or
+        length > 0x7FFFFFFF) {
+        throw std::runtime_error("serialized ArrayList is truncated");
+    }
+
+    *checked = false;
+    if (verify and (getLittleEndian(buffer + 6, 2) & SERIAL_CHECKSUM_FLAG)) {
+        CharArrayList chars = wrap(buffer, bufferSize, false);
+        if (chars.hash() != getLittleEndian(buffer + 16, 8)) {
+            throw std::runtime_error("serialized ArrayList is corrupt");
+        }
+        *checked = true;
+    }
+    return length;
+}
+
+/*
+ * name:      deserialize
+ * purpose:   reads a CharArrayList written by serialize
+ * arguments: the serialized bytes, how many there are, and whether to
+ *            check the checksum if there is one
+ * returns:   a CharArrayList with its own copy of the chars, or an error
+ *            message if the bytes are not valid
+ * effects:   none
+ */
+CharArrayList CharArrayList::deserialize(const char *buffer, long bufferSize,
+                                         bool verify) {
+    CharArrayList list = wrap(buffer, bufferSize, verify);
+    list.resize(list.numItems);
+    return list;
+}
+
+/*
+ * name:      wrap
+ * purpose:   reads a CharArrayList written by serialize without copying
+ * arguments: the serialized bytes (e.g. an mmapped file), how many there
+ *            are, and whether to check the checksum if there is one
+ * returns:   a CharArrayList that reads its chars straight from the buffer,
+ *            or an error message if the bytes are not valid
+ * effects:   the buffer is never written to and must outlive the list or
+ *            its first change, which copies the chars into a new array
+ */
+CharArrayList CharArrayList::wrap(const char *buffer, long bufferSize,
+                                  bool verify) {
+    bool checked;
+    long length = readHeader(buffer, bufferSize, verify, &checked);
+
+    CharArrayList list;
+    if (length > 0) {
+        list.data = const_cast<char *>(buffer + SERIAL_HEADER_SIZE);
+        list.numItems = length;
+        list.capacity = length;
+        list.borrowed = true;
+    }
+    // a checked checksum is the hash, so hashing the list is free
+    if (checked) {
+        list.cachedHash.store(getLittleEndian(buffer + 16, 8),
+                              std::memory_order_relaxed);
+        list.hashValid.store(true, std::memory_order_release);
+    }
+    return list;
+}
+
+/*
+ * name:      isWrapped
+ * purpose:   determines if the CharArrayList reads from a wrapped buffer
+ * arguments: none
+ * returns:   true if the chars live in memory the list does not own
+ * effects:   none
+ */
+bool CharArrayList::isWrapped() const {
+    return borrowed;
+}
+
+/*
+ * name:      split
+ * purpose:   splits the CharArrayList at every occurrence of a delimiter
+ * arguments: the delimiter
+ * returns:   views of the pieces between delimiters, in order. A list with
+ *            n delimiters gives n + 1 pieces, some of which may be empty
+ * effects:   none, but the views are only valid until the list changes
+ */
+std::vector<CharArrayListView> CharArrayList::split(char delim) const {
+    // count the delimiters first so the result is allocated exactly once
+    int count = 0;
+    const char *end = data + numItems;
+    const char *p = data;
+    while (p < end) {
+        const void *hit = std::memchr(p, delim, end - p);
+        if (hit == nullptr) {
+            break;
+        }
+        count++;
+        p = static_cast<const char *>(hit) + 1;
+    }
+
+    std::vector<CharArrayListView> pieces;
+    pieces.reserve(count + 1);
+    CharArrayListTokenizer tokens(*this, delim);
+    CharArrayListView piece;
+    while (tokens.next(piece)) {
+        pieces.push_back(piece);
+    }
+    return pieces;
+}
+
+/*
+ * name:      join
+ * purpose:   joins pieces into one CharArrayList with a separator between
+ * arguments: the pieces, in order, and the separator
+ * returns:   a CharArrayList of all the pieces and separators
+ * effects:   works out the total size first so the result is allocated
+ *            exactly once
+ */
+CharArrayList CharArrayList::join(const std::vector<CharArrayListView> &pieces,
+                                  char sep) {
+    CharArrayList result;
+    if (pieces.empty()) {
+        return result;
+    }
+
+    int total = pieces.size() - 1;
+    for (size_t i = 0; i < pieces.size(); i++) {
+        total += pieces[i].size();
+    }
+    result.resize(total);
+
+    for (size_t i = 0; i < pieces.size(); i++) {
+        if (i > 0) {
+            result.appendChars(&sep, 1);
+        }
+        result.appendChars(pieces[i].start, pieces[i].size());
+    }
+    return result;
+}
+
+/*
+ * name:      join
+ * purpose:   joins pieces into one CharArrayList
+ * arguments: the pieces, in order
+ * returns:   a CharArrayList of all the pieces back to back
+ * effects:   works out the total size first so the result is allocated
+ *            exactly once
+ */
+CharArrayList CharArrayList::join(
+    const std::vector<CharArrayListView> &pieces) {
+    int total = 0;
+    for (size_t i = 0; i < pieces.size(); i++) {
+        total += pieces[i].size();
+    }
+
+    CharArrayList result;
+    result.resize(total);
+    for (size_t i = 0; i < pieces.size(); i++) {
+        result.appendChars(pieces[i].start, pieces[i].size());
+    }
+    return result;
+}
+
+/*
+ * name:      slice
+ * purpose:   makes a view of part of the CharArrayList
+ * arguments: the index of the first element and one past the last
+ * returns:   a view of elements [begin, end), or an error if the range is
+ *            out of order or out of range
+ * effects:   none; nothing is copied. The view is only valid until the
+ *            list moves its elements to a new array
+ */
+CharArrayListView CharArrayList::slice(int begin, int end) const {
+    if (begin > numItems or begin < 0){
+        throw std::range_error( "index (" + std::to_string(begin) +
+        ") not in range [0.." + std::to_string(numItems) + "]" );
+    }
+    if (end > numItems or end < begin){
+        throw std::range_error( "index (" + std::to_string(end) +
+        ") not in range [" + std::to_string(begin) + ".." +
+        std::to_string(numItems) + "]" );
+    }
+    return CharArrayListView(*this, begin, end);
+}
+
+/*
+ * name:      countChars
+ * purpose:   adds up how often each char value appears in a run of chars
+ * arguments: the chars, how many there are, and the 256 counts to add to
+ * returns:   none
+ * effects:   counts[c] grows by the number of times unsigned char c appears
+ */
+static void countChars(const char *chars, int size, int counts[256]) {
+    // four tables, so runs of the same char do not make each increment
+    // wait for the one before it to be stored
+    int tables[4][256] = {};
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(chars);
+    int i = 0;
+    for (; i + BLOCK <= size; i += BLOCK) {
+        PREFETCH(p + i + PREFETCH_DISTANCE);
+        for (int j = i; j < i + BLOCK; j += 4) {
+            tables[0][p[j]]++;
+            tables[1][p[j + 1]]++;
+            tables[2][p[j + 2]]++;
+            tables[3][p[j + 3]]++;
+        }
+    }
+    for (; i + 4 <= size; i += 4) {
+        tables[0][p[i]]++;
+        tables[1][p[i + 1]]++;
+        tables[2][p[i + 2]]++;
+        tables[3][p[i + 3]]++;
+    }
+    for (; i < size; i++) {
+        tables[0][p[i]]++;
+    }
+    for (int c = 0; c < 256; c++) {
+        counts[c] += tables[0][c] + tables[1][c] + tables[2][c] +
+                     tables[3][c];
+    }
+}
+
+/*
+ * name:      histogram
+ * purpose:   counts how often each char value appears in the CharArrayList
+ * arguments: how many threads to count with (1 counts on this thread)
+ * returns:   256 counts, indexed by the unsigned value of each char
+ * effects:   none
+ */
+std::array<int, 256> CharArrayList::histogram(int numThreads) const {
+    std::array<int, 256> counts = {};
+
+    // small lists are not worth starting threads for
+    const int MIN_CHARS_PER_THREAD = 1 << 16;
+    numThreads = std::min(numThreads, numItems / MIN_CHARS_PER_THREAD);
+    if (numThreads <= 1) {
+        countChars(data, numItems, counts.data());
+        return counts;
+    }
+
+    // each thread counts its own stretch into its own counts
+    std::vector<std::array<int, 256>> partial(numThreads);
+    std::vector<std::thread> threads;
+    int chunk = numItems / numThreads;
+    for (int t = 0; t < numThreads; t++) {
+        int begin = t * chunk;
+        int end = t == numThreads - 1 ? numItems : begin + chunk;
+        partial[t] = {};
+        threads.emplace_back(countChars, data + begin, end - begin,
+                             partial[t].data());
+    }
+    for (int t = 0; t < numThreads; t++) {
+        threads[t].join();
+        for (int c = 0; c < 256; c++) {
+            counts[c] += partial[t][c];
+        }
+    }
+    return counts;
+}
+
+/*
+ * name:      sort
+ * purpose:   sorts the CharArrayList
+ * arguments: how many threads to count with (see histogram)
+ * returns:   none
+ * effects:   puts the elements in increasing order of their unsigned
+ *            values with a counting sort, in O(n) time and in place
+ */
+void CharArrayList::sort(int numThreads) {
+    if (numItems == 0) {
+        return;
+    }
+    std::array<int, 256> counts = histogram(numThreads);
+    contentsChanged();
+    char *out = data;
+    for (int c = 0; c < 256; c++) {
+        std::memset(out, c, counts[c]);
+        out += counts[c];
+    }
+    reindexFrom(0);
+}
+
+/*
+ * name:      unique
+ * purpose:   removes every repeat of a char seen earlier in the list
+ * arguments: none
+ * returns:   none
+ * effects:   keeps only the first occurrence of each char value, in order
+ */
+void CharArrayList::unique() {
+    contentsChanged();
+    bool seen[256] = {};
+    int kept = 0;
+    for (int i = 0; i < numItems; i++) {
+        unsigned char c = data[i];
+        if (not seen[c]) {
+            seen[c] = true;
+            data[kept++] = c;
+        }
+    }
+    numItems = kept;
+    reindexFrom(0);
+    trimIfSparse();
+}
+
+/*
+ * name:      dedupeAdjacent
+ * purpose:   collapses each run of equal chars into a single char
+ * arguments: none
+ * returns:   none
+ * effects:   removes every element equal to the one before it
+ */
+void CharArrayList::dedupeAdjacent() {
+    if (numItems == 0) {
+        return;
+    }
+    contentsChanged();
+    int kept = 1;
+    for (int i = 1; i < numItems; i++) {
+        if (data[i] != data[kept - 1]) {
+            data[kept++] = data[i];
+        }
+    }
+    numItems = kept;
+    reindexFrom(1);
+    trimIfSparse();
+}
+
+/*
+ * name:      commonPrefix
+ * purpose:   measures how far two runs of chars agree from the front
+ * arguments: the two runs and the length of the shorter
+ * returns:   the number of leading chars they share
+ * effects:   none
+ */
+static int commonPrefix(const char *a, const char *b, int size) {
+    // compare eight chars at a time; the lowest set bit of the xor is the
+    // first difference on a little endian machine
+    int i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t x, y;
+        std::memcpy(&x, a + i, 8);
+        std::memcpy(&y, b + i, 8);
+        if (x != y) {
+            if constexpr (std::endian::native == std::endian::little) {
+                return i + __builtin_ctzll(x ^ y) / 8;
+            }
+            break;
+        }
+    }
+    while (i < size and a[i] == b[i]) {
+        i++;
+    }
+    return i;
+}
+
+/*
+ * name:      commonSuffix
+ * purpose:   measures how far two runs of chars agree from the back
+ * arguments: the ends of the two runs and the length of the shorter
+ * returns:   the number of trailing chars they share
+ * effects:   none
+ */
+static int commonSuffix(const char *aEnd, const char *bEnd, int size) {
+    int i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t x, y;
+        std::memcpy(&x, aEnd - i - 8, 8);
+        std::memcpy(&y, bEnd - i - 8, 8);
+        if (x != y) {
+            if constexpr (std::endian::native == std::endian::little) {
+                return i + __builtin_clzll(x ^ y) / 8;
+            }
+            break;
+        }
+    }
+    while (i < size and aEnd[-i - 1] == bEnd[-i - 1]) {
+        i++;
+    }
+    return i;
+}
+
+/*
+ * name:      diffRange
+ * purpose:   finds the shortest edit script between two ranges of chars
+ * arguments: the chars of a and the range [aLo, aHi) of them, the chars of
+ *            b and the range [bLo, bHi), the list to add edits to, and
+ *            scratch arrays for the forward and backward searches
+ * returns:   none
+ * effects:   adds REMOVEs and INSERTs turning a's range into b's, indexed
+ *            by position in a and in increasing order. Uses Myers' linear
+ *            space refinement: find the middle snake of an optimal path,
+ *            then solve the two halves on either side of it
+ */
+static void diffRange(const char *a, int aLo, int aHi, const char *b,
+                      int bLo, int bHi,
+                      std::vector<CharArrayList::Edit> &edits,
+                      std::vector<int> &forward, std::vector<int> &backward) {
+    int prefix = commonPrefix(a + aLo, b + bLo,
+                              std::min(aHi - aLo, bHi - bLo));
+    aLo += prefix;
+    bLo += prefix;
+    int suffix = commonSuffix(a + aHi, b + bHi,
+                              std::min(aHi - aLo, bHi - bLo));
+    aHi -= suffix;
+    bHi -= suffix;
+
+    if (aLo == aHi) {
+        for (int j = bLo; j < bHi; j++) {
+            edits.push_back({ CharArrayList::INSERT, b[j], aLo });
+        }
+        return;
+    }
+    if (bLo == bHi) {
+        for (int i = aLo; i < aHi; i++) {
+            edits.push_back({ CharArrayList::REMOVE, 0, i });
+        }
+        return;
+    }
+
+    // forward[k + offset] is the furthest x reached on diagonal k = x - y
+    // from the start; backward[k + offset] is the same from the end, on
+    // the reversed ranges
+    int n = aHi - aLo;
+    int m = bHi - bLo;
+    int delta = n - m;
+    bool odd = delta % 2 != 0;
+    int maxD = (n + m + 1) / 2;
+    int offset = maxD + 1;
+    forward.assign(2 * offset + 1, 0);
+    backward.assign(2 * offset + 1, 0);
+
+    int snakeX = 0, snakeY = 0, snakeU = 0, snakeV = 0;
+    bool found = false;
+    for (int d = 0; d <= maxD and not found; d++) {
+        for (int k = -d; k <= d; k += 2) {
+            int x;
+            if (k == -d or (k != d and forward[offset + k - 1] <
+                                       forward[offset + k + 1])) {
+                x = forward[offset + k + 1];
+            } else {
+                x = forward[offset + k - 1] + 1;
+            }
+            int y = x - k;
+            int startX = x, startY = y;
+            while (x < n and y < m and a[aLo + x] == b[bLo + y]) {
+                x++;
+                y++;
+            }
+            forward[offset + k] = x;
+            int reverseK = delta - k;
+            if (odd and reverseK >= -(d - 1) and reverseK <= d - 1 and
+                x + backward[offset + reverseK] >= n) {
+                snakeX = startX;
+                snakeY = startY;
+                snakeU = x;
+                snakeV = y;
+                found = true;
+                break;
+            }
+        }
+        if (found) {
+            break;
+        }
+        for (int k = -d; k <= d; k += 2) {
+            int x;
+            if (k == -d or (k != d and backward[offset + k - 1] <
+                                       backward[offset + k + 1])) {
+                x = backward[offset + k + 1];
+            } else {
+                x = backward[offset + k - 1] + 1;
+            }
+            int y = x - k;
+            int startX = x, startY = y;
+            while (x < n and y < m and
+                   a[aHi - 1 - x] == b[bHi - 1 - y]) {
+                x++;
+                y++;
+            }
+            backward[offset + k] = x;
+            int forwardK = delta - k;
+            if (not odd and forwardK >= -d and forwardK <= d and
+                x + forward[offset + forwardK] >= n) {
+                snakeX = n - x;
+                snakeY = m - y;
+                snakeU = n - startX;
+                snakeV = m - startY;
+                found = true;
+                break;
+            }
+        }
+    }
+
+    diffRange(a, aLo, aLo + snakeX, b, bLo, bLo + snakeY, edits, forward,
+              backward);
+    diffRange(a, aLo + snakeU, aHi, b, bLo + snakeV, bHi, edits, forward,
+              backward);
+}
+
+/*
+ * name:      diff
+ * purpose:   finds a shortest list of inserts and removes turning one
+ *            CharArrayList into another
+ * arguments: the old list and the new list
+ * returns:   the edits, indexed by position in the old list the way
+ *            applyEdits expects, so a.applyEdits(...) makes a equal to b
+ * effects:   none. Runs in O((n + m) D) time and O(n + m) space for D
+ *            edits, after trimming the shared front and back
+ */
+std::vector<CharArrayList::Edit> CharArrayList::diff(const CharArrayList &a,
+                                                     const CharArrayList &b) {
+    std::vector<Edit> edits;
+    std::vector<int> forward, backward;
+    diffRange(a.data, 0, a.numItems, b.data, 0, b.numItems, edits, forward,
+              backward);
+    return edits;
+}
+
+/*
+ * name:      editDistance
+ * purpose:   computes the Levenshtein distance between two CharArrayLists
+ * arguments: the two lists
+ * returns:   the fewest single char inserts, removes and replaces that
+ *            turn one into the other
+ * effects:   none. After trimming the shared front and back, uses the
+ *            Myers/Hyyrö bit-vector algorithm (O(n) for a shorter side of
+ *            at most 64 chars), and a row-at-a-time table otherwise
+ */
+int CharArrayList::editDistance(const CharArrayList &a,
+                                const CharArrayList &b) {
+    // the shorter list is the pattern, the longer one the text
+    const CharArrayList &shorter = a.numItems <= b.numItems ? a : b;
+    const CharArrayList &longer = a.numItems <= b.numItems ? b : a;
+    const char *p = shorter.data;
+    const char *t = longer.data;
+    int m = shorter.numItems;
+    int n = longer.numItems;
+    int prefix = commonPrefix(p, t, m);
+    p += prefix;
+    t += prefix;
+    m -= prefix;
+    n -= prefix;
+    int suffix = commonSuffix(p + m, t + n, m);
+    m -= suffix;
+    n -= suffix;
+    if (m == 0) {
+        return n;
+    }
+
+    if (m <= 64) {
+        // bit i of the vertical deltas tells how row i + 1 of the current
+        // column differs from row i
+        uint64_t peq[256] = {};
+        for (int i = 0; i < m; i++) {
+            peq[static_cast<unsigned char>(p[i])] |= 1ULL << i;
+        }
+        uint64_t mask = m == 64 ? ~0ULL : (1ULL << m) - 1;
+        uint64_t high = 1ULL << (m - 1);
+        uint64_t pv = mask;
+        uint64_t mv = 0;
+        int score = m;
+        for (int j = 0; j < n; j++) {
+            uint64_t eq = peq[static_cast<unsigned char>(t[j])];
+            uint64_t xv = eq | mv;
+            uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+            uint64_t ph = mv | ~(xh | pv);
+            uint64_t mh = pv & xh;
+            if (ph & high) {
+                score++;
+            } else if (mh & high) {
+                score--;
+            }
+            // row 0 grows by one every column
+            ph = (ph << 1) | 1;
+            mh <<= 1;
+            pv = (mh | ~(xv | ph)) & mask;
+            mv = ph & xv & mask;
+        }
+        return score;
+    }
+
+    std::vector<int> row(m + 1);
+    for (int i = 0; i <= m; i++) {
+        row[i] = i;
+    }
+    for (int j = 1; j <= n; j++) {
+        int diagonal = row[0];
+        row[0] = j;
+        for (int i = 1; i <= m; i++) {
+            int above = row[i];
+            row[i] = std::min({ row[i] + 1, row[i - 1] + 1,
+                                diagonal + (p[i - 1] != t[j - 1]) });
+            diagonal = above;
+        }
+    }
+    return row[m];
+}
@@ -12,16 +12,38 @@
 #define CHAR_ARRAY_LIST_H
 
 #include <string>
+#include <cstdint>
+#include <array>
+#include <atomic>
+#include <optional>
+#include <vector>
+#include <compare>
+#include <functional>
+#include "CharArrayListView.h"
 
 class CharArrayList {
 public:
+    // A single position-tagged edit used by applyEdits. Every index refers
+    // to a position in the list as it was before the batch is applied.
+    enum EditKind { INSERT, REMOVE, REPLACE };
+    struct Edit {
+        EditKind kind;
+        char c;     // ignored for REMOVE
+        int index;
+    };
+
+    // ASCII character classes counted by countIf
+    enum CharClass { DIGIT, WHITESPACE, ALPHA };
+
     CharArrayList();    // Default Constructor
     CharArrayList(char c);  // Constructor with initial char variable
     CharArrayList(char arr[], int size);    // Constructor with intial arr 
     CharArrayList(const CharArrayList &other);  // Copy Constructor
+    CharArrayList(CharArrayList &&other);   // Move Constructor
     ~CharArrayList();   // Destructor
     CharArrayList &operator=(const CharArrayList &other);   // deepcopy
     // assignent operator
+    CharArrayList &operator=(CharArrayList &&other);    // move assignment
 
     // Other Member functions
     bool isEmpty() const;
@@ -30,6 +52,8 @@ public:
     char first() const;
     char last() const;
     char elementAt(int index) const;
+    char operator[](int index) const;
+    std::optional<char> tryElementAt(int index) const;
     std::string toString() const;
     std::string toReverseString() const;
     void pushAtBack(char c);
@@ -40,16 +64,380 @@ public:
     void popFromBack();
     void removeAt(int index);
     void replaceAt(char c, int index);
+    bool tryInsertAt(char c, int index);
+    bool tryRemoveAt(int index);
+    bool tryReplaceAt(char c, int index);
+    bool tryPopFromFront();
+    bool tryPopFromBack();
     void concatenate(CharArrayList *other);
     void shrink();
+    void applyEdits(const Edit edits[], int numEdits);
+    int findSubsequence(const CharArrayList &pattern, int start = 0) const;
+    int countSubsequence(const CharArrayList &pattern) const;
+    int replaceAll(const CharArrayList &pattern,
+                   const CharArrayList &replacement);
+    void toUpper();
+    void toLower();
+    void translate(const uint8_t table[256]);
+    int countIf(CharClass charClass) const;
+    bool isValidUtf8() const;
+    int codePointCount() const;
+    void enableCodePointIndex(int every);
+    void disableCodePointIndex();
+    int codePointOffset(int n) const;
+    CharArrayList codePointRange(int begin, int end) const;
+    bool operator==(const CharArrayList &other) const;
+    std::strong_ordering operator<=>(const CharArrayList &other) const;
+    uint64_t hash() const;
+    void setAutoTrim(double threshold);
+    void setAligned(bool on);
+    bool isAligned() const;
+    static long trimAll();
+    static long trimmableSlack();
+
+    // binary format: a SERIAL_HEADER_SIZE byte header, then the chars,
+    // padded so the next record also starts on a 64 byte boundary
+    static const int SERIAL_HEADER_SIZE = 64;
+    long serializedSize() const;
+    long serialize(char *buffer, long bufferSize,
+                   bool checksum = true) const;
+    void serialize(int fd, bool checksum = true) const;
+    static CharArrayList deserialize(const char *buffer, long bufferSize,
+                                     bool verify = true);
+    static CharArrayList wrap(const char *buffer, long bufferSize,
+                              bool verify = true);
+    bool isWrapped() const;
+    std::vector<CharArrayListView> split(char delim) const;
+    static CharArrayList join(const std::vector<CharArrayListView> &pieces,
+                              char sep);
+    static CharArrayList join(const std::vector<CharArrayListView> &pieces);
+    CharArrayListView slice(int begin, int end) const;
+    std::array<int, 256> histogram(int numThreads = 1) const;
+    void sort(int numThreads = 1);
+    void unique();
+    void dedupeAdjacent();
+    static std::vector<Edit> diff(const CharArrayList &a,
+                                  const CharArrayList &b);
+    static int editDistance(const CharArrayList &a, const CharArrayList &b);
 
 private:
+    // these read straight from the array. CharArrayListStream also fills
+    // its own chunk buffers in place, and appends through appendChars
+    friend class CharArrayListWriter;
+    friend class CharArrayListTokenizer;
+    friend class CharArrayListView;
+    friend class CharArrayListStream;
+
     int numItems;
     int capacity;
     char *data;
 
+    // true while data points into memory the list does not own (see wrap);
+    // the first change copies it into an array of the list's own
+    bool borrowed;
+
+    // bumped every time data moves to a different array, so debug builds
+    // can catch CharArrayListViews that outlive the array they look at
+    unsigned int generation;
+
+    // optional sampled code point index (see enableCodePointIndex),
+    // nullptr when it is off. Every mutating function brings it up to date
+    // after it writes, so looking code points up never changes it
+    struct CodePointIndex;
+    CodePointIndex *codePoints;
+
+    // xxHash64 of the contents, valid until contentsChanged is called.
+    // Threads hashing the same list at once may both fill it in, so both
+    // are atomic and the flag is set (release) after the hash is stored
+    mutable std::atomic<uint64_t> cachedHash;
+    mutable std::atomic<bool> hashValid;
+
+    // the CharArrayAllocator tag the array is charged to
+    int tag;
+
+    // true for the cache line aligned layout (see setAligned)
+    bool aligned;
+
+    // auto-trim policy, 0 when off (see setAutoTrim)
+    double trimThreshold;
+    static const int MIN_TRIM_CAPACITY = 64;
+
     // helper functions
     void expand();    
+    void resize(int newCapacity);
+    int paddedCapacity(int size) const;
+    char *allocateArray(int newCapacity, int used);
+    int mappedSize() const;
+    void trimIfSparse();
+    void appendChars(const char *chars, int size);
+    static uint64_t hashChars(const char *chars, int size);
+    static int search(const char *text, int textSize, const char *pattern,
+                      int patternSize, int start);
+    void contentsChanged();
+    void charInserted(int index);
+    void charRemoved(int index, char c);
+    void charReplaced(int index, char old);
+    void codePointAdded();
+    void codePointRemoved();
+    void reindexFrom(int index);
+    void releaseData();
+    [[noreturn]] void throwIndexError(int index) const;
+    [[noreturn]] static void throwEmptyError(const char *message);
+    static long readHeader(const char *buffer, long bufferSize, bool verify,
+                           bool *checked);
+};
+
+// The accessors below run in callers' inner loops, so they are defined here
+// where they can be inlined. The checked ones throw through out of line
+// helpers to keep the message building off the fast path.
+
+/*
+ * name:      size
+ * purpose:   determine the number of items in the CharArrayList
+ * arguments: none
+ * returns:   number of elements currently stored in the CharArrayList
+ * effects:   none
+ */
+inline int CharArrayList::size() const {
+    return numItems;
+}
+
+/*
+ * name:      isEmpty
+ * purpose:   determines if the CharArrayList is empty or not
+ * arguments: none
+ * returns:   true if CharArrayList contains no elements, false otherwise
+ * effects:   none
+ */
+inline bool CharArrayList::isEmpty() const {
+    return numItems == 0;
+}
+
+/*
+ * name:      first
+ * purpose:   determines the first element of the CharArrayList
+ * arguments: none
+ * returns:   the first element of the CharArrayList or an error if the list
+ *            is empty
+ * effects:   none
+ */
+inline char CharArrayList::first() const {
+    if (isEmpty()){
+        // if the CharArrayList is empty throw an error message
+        throwEmptyError("cannot get first of empty ArrayList");
+    } else {
+        return data[0];
+    }
+}
+
+/*
+ * name:      last
+ * purpose:   determines the last element of the CharArrayList
+ * arguments: none
+ * returns:   the last element of the CharArrayList or an error if the list
+ *            is empty
+ * effects:   none
+ */
+inline char CharArrayList::last() const {
+    if (isEmpty()){
+        // if the CharArrayList is empty throw an error message
+        throwEmptyError("cannot get last of empty ArrayList");
+    } else {
+        return data[numItems - 1];
+    }
+}
+
+/*
+ * name:      elementAt
+ * purpose:   determines the element at a given index in the CharArrayList
+ * arguments: index of element
+ * returns:   the corresponding element of the CharArrayList or an error if the 
+ *            list is empty
+ * effects:   none
+ */
+inline char CharArrayList::elementAt(int index) const {
+    if (index >= numItems or index < 0){
+        // if the index is out of range of the CharArrayList, throw an error 
+        // message
+        throwIndexError(index);
+    } else {
+        return data[index];
+    }
+}
+
+/*
+ * name:      operator[]
+ * purpose:   gets the element at a given index without checking the index
+ * arguments: index of element, which must be in range [0..size())
+ * returns:   the corresponding element of the CharArrayList
+ * effects:   none
+ */
+inline char CharArrayList::operator[](int index) const {
+    return data[index];
+}
+
+/*
+ * name:      tryElementAt
+ * purpose:   gets the element at a given index without throwing
+ * arguments: index of element
+ * returns:   the element, or nothing if the index is out of range
+ * effects:   none
+ */
+inline std::optional<char> CharArrayList::tryElementAt(int index) const {
+    if (index >= numItems or index < 0) {
+        return std::nullopt;
+    }
+    return data[index];
+}
+
+/*
+ * name:      tryReplaceAt
+ * purpose:   replaces the element at a given index without throwing
+ * arguments: the new element and its index
+ * returns:   false if the index is out of range, true otherwise
+ * effects:   replaces the element if the index is in range
+ */
+inline bool CharArrayList::tryReplaceAt(char c, int index) {
+    if (index >= numItems or index < 0) {
+        return false;
+    }
+    contentsChanged();
+    char old = data[index];
+    data[index] = c;
+    if (codePoints != nullptr) {
+        charReplaced(index, old);
+    }
+    return true;
+}
+
+/*
+ * name:      tryInsertAt
+ * purpose:   inserts an element at a given index without throwing
+ * arguments: the element and the index to put it at, in range [0..size()]
+ * returns:   false if the index is out of range, true otherwise
+ * effects:   inserts the element if the index is in range
+ */
+inline bool CharArrayList::tryInsertAt(char c, int index) {
+    if (index > numItems or index < 0) {
+        return false;
+    }
+    insertAt(c, index);
+    return true;
+}
+
+/*
+ * name:      tryRemoveAt
+ * purpose:   removes the element at a given index without throwing
+ * arguments: the element index
+ * returns:   false if the index is out of range, true otherwise
+ * effects:   removes the element if the index is in range
+ */
+inline bool CharArrayList::tryRemoveAt(int index) {
+    if (index >= numItems or index < 0) {
+        return false;
+    }
+    removeAt(index);
+    return true;
+}
+
+/*
+ * name:      tryPopFromBack
+ * purpose:   removes the last element without throwing
+ * arguments: none
+ * returns:   false if the list is empty, true otherwise
+ * effects:   removes the last element if there is one
+ */
+inline bool CharArrayList::tryPopFromBack() {
+    if (isEmpty()) {
+        return false;
+    }
+    popFromBack();
+    return true;
+}
+
+/*
+ * name:      tryPopFromFront
+ * purpose:   removes the first element without throwing
+ * arguments: none
+ * returns:   false if the list is empty, true otherwise
+ * effects:   removes the first element if there is one
+ */
+inline bool CharArrayList::tryPopFromFront() {
+    if (isEmpty()) {
+        return false;
+    }
+    popFromFront();
+    return true;
+}
+
+/*
+ * name:      pushAtBack
+ * purpose:   push the provided integer into the back of the CharArrayList
+ * arguments: a char to add to the back of the list
+ * returns:   none
+ * effects:   increases num elements of CharArrayList by 1,
+ *            adds element to list
+ */
+inline void CharArrayList::pushAtBack(char c) {
+    // if the array list is at capacity, expand it
+    if (numItems >= capacity) {
+        expand();
+    }
+    // add the given char to the end of the array list
+    contentsChanged();
+    data[numItems] = c;
+    numItems++;
+    if (codePoints != nullptr) {
+        charInserted(numItems - 1);
+    }
+}
+
+/*
+ * name:      replaceAt
+ * purpose:   replace the element at the given index in the CharArrayList
+ * arguments: the element being added
+ * returns:   error message if the index is out of range
+ * effects:   replaces given element in the CharArrayList
+ */
+inline void CharArrayList::replaceAt(char c, int index) {
+    // if the index is out of range of the CharArrayList, throw an error 
+    // message
+    if (index >= numItems or index < 0){
+        throwIndexError(index);
+    }
+    // replace the element at the given index
+    contentsChanged();
+    char old = data[index];
+    data[index] = c;
+    if (codePoints != nullptr) {
+        charReplaced(index, old);
+    }
+}
+
+/*
+ * name:      contentsChanged
+ * purpose:   keeps cached information about the contents up to date
+ * arguments: none
+ * returns:   none
+ * effects:   forgets the cached hash, and copies a wrapped list into its
+ *            own array. Called by every mutating function before it writes;
+ *            the code point index is brought up to date afterwards (see
+ *            charInserted and reindexFrom)
+ */
+inline void CharArrayList::contentsChanged() {
+    if (borrowed) {
+        resize(numItems);
+    }
+    // only the thread changing the list can be looking at it
+    hashValid.store(false, std::memory_order_relaxed);
+}
+
+// lets CharArrayLists be keys of unordered containers
+template <>
+struct std::hash<CharArrayList> {
+    size_t operator()(const CharArrayList &list) const {
+        return list.hash();
+    }
 };
 
 #endif
@@ -0,0 +1,315 @@
+/*
+ *  CharArrayListColumn.cpp
+ *  Name: Leo Kim
+ *  Date: 10/19/2026
+ *
+ *  Purpose: Implementation of the CharArrayListColumn class. Rows are
+ *           only cheap to grow at the end of the column; growing an
+ *           earlier row moves every char after it.
+ *
+ */
+
+#include "CharArrayListColumn.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+
+/*
+ * name:      CharArrayListColumn default constructor
+ * purpose:   initialize a column with no rows
+ * arguments: none
+ * returns:   none
+ * effects:   rows() is 0
+ */
+CharArrayListColumn::CharArrayListColumn() {
+    offsets.push_back(0);
+}
+
+/*
+ * name:      isEmpty
+ * purpose:   determines if the column has any rows
+ * arguments: none
+ * returns:   true if there are no rows (empty rows still count as rows)
+ * effects:   none
+ */
+bool CharArrayListColumn::isEmpty() const {
+    return rows() == 0;
+}
+
+/*
+ * name:      rows
+ * purpose:   determines the number of rows
+ * arguments: none
+ * returns:   the number of rows in the column
+ * effects:   none
+ */
+int CharArrayListColumn::rows() const {
+    return offsets.size() - 1;
+}
+
+/*
+ * name:      totalSize
+ * purpose:   determines the number of chars in all the rows together
+ * arguments: none
+ * returns:   the sum of the sizes of every row
+ * effects:   none
+ */
+int CharArrayListColumn::totalSize() const {
+    return offsets.back();
+}
+
+/*
+ * name:      rowSize
+ * purpose:   determines the number of chars in one row
+ * arguments: the row
+ * returns:   the size of the row
+ * effects:   throws a range_error if the row does not exist
+ */
+int CharArrayListColumn::rowSize(int row) const {
+    checkRow(row);
+    return offsets[row + 1] - offsets[row];
+}
+
+/*
+ * name:      elementAt
+ * purpose:   determines the element at a given index in a row
+ * arguments: the row and the index of the element in it
+ * returns:   the corresponding element
+ * effects:   throws a range_error if the row or index does not exist
+ */
+char CharArrayListColumn::elementAt(int row, int index) const {
+    int size = rowSize(row);
+    if (index >= size or index < 0) {
+        throw std::range_error( "index (" + std::to_string(index) +
+        ") not in range [0.." + std::to_string(size) + ")" );
+    }
+    return chars[offsets[row] + index];
+}
+
+/*
+ * name:      toString
+ * purpose:   makes a string out of one row
+ * arguments: the row
+ * returns:   the row in the same form CharArrayList::toString gives
+ * effects:   throws a range_error if the row does not exist
+ */
+std::string CharArrayListColumn::toString(int row) const {
+    return view(row).toString();
+}
+
+/*
+ * name:      view
+ * purpose:   looks at one row without copying it
+ * arguments: the row
+ * returns:   a view of the row's chars, valid until the column next changes
+ * effects:   throws a range_error if the row does not exist
+ */
+CharArrayListView CharArrayListColumn::view(int row) const {
+    checkRow(row);
+    return CharArrayListView(chars.data() + offsets[row],
+                             offsets[row + 1] - offsets[row]);
+}
+
+/*
+ * name:      materialize
+ * purpose:   copies one row into a CharArrayList of its own
+ * arguments: the row
+ * returns:   a new CharArrayList with the row's chars
+ * effects:   throws a range_error if the row does not exist
+ */
+CharArrayList CharArrayListColumn::materialize(int row) const {
+    return CharArrayList::join({ view(row) });
+}
+
+/*
+ * name:      pushAtBack
+ * purpose:   adds a char to the end of a row
+ * arguments: the row and the char
+ * returns:   none
+ * effects:   grows the row by one. O(1) amortized for the last row; for
+ *            any other row every char after it moves up one place
+ */
+void CharArrayListColumn::pushAtBack(int row, char c) {
+    checkRow(row);
+    checkGrowth(1);
+    chars.insert(chars.begin() + offsets[row + 1], c);
+    for (int r = row + 1; r < static_cast<int>(offsets.size()); r++) {
+        offsets[r]++;
+    }
+}
+
+/*
+ * name:      appendRow
+ * purpose:   adds a row to the end of the column
+ * arguments: the chars of the new row, which are copied
+ * returns:   none
+ * effects:   rows() grows by one
+ */
+void CharArrayListColumn::appendRow(const CharArrayListView &rowChars) {
+    appendRows({ rowChars });
+}
+
+/*
+ * name:      appendRow
+ * purpose:   adds a copy of a CharArrayList as a row at the end
+ * arguments: the list
+ * returns:   none
+ * effects:   rows() grows by one
+ */
+void CharArrayListColumn::appendRow(const CharArrayList &list) {
+    appendRows({ list.slice(0, list.size()) });
+}
+
+/*
+ * name:      appendRows
+ * purpose:   adds many rows to the end of the column at once
+ * arguments: the chars of each new row, in order
+ * returns:   none
+ * effects:   grows the arrays at most once, then copies each row in. The
+ *            rows may be views of this column
+ */
+void CharArrayListColumn::appendRows(
+    const std::vector<CharArrayListView> &rowsToAdd) {
+    long extra = 0;
+    for (const CharArrayListView &piece : rowsToAdd) {
+        extra += piece.size();
+    }
+    checkGrowth(extra);
+
+    // views of this column would be left pointing at the old array once
+    // it grows, so remember where in it they start instead
+    std::less<const char *> before;
+    const char *begin = chars.data();
+    const char *end = begin + chars.size();
+    std::vector<long> ownStart(rowsToAdd.size(), -1);
+    for (size_t i = 0; i < rowsToAdd.size(); i++) {
+        const char *start = rowsToAdd[i].start;
+        if (rowsToAdd[i].length > 0 and not before(start, begin) and
+            before(start, end)) {
+            ownStart[i] = start - begin;
+        }
+    }
+
+    // grow at least geometrically, so appending rows one at a time is
+    // O(1) amortized per char
+    size_t neededChars = chars.size() + extra;
+    if (neededChars > chars.capacity()) {
+        chars.reserve(std::max(neededChars, 2 * chars.capacity()));
+    }
+    size_t neededOffsets = offsets.size() + rowsToAdd.size();
+    if (neededOffsets > offsets.capacity()) {
+        offsets.reserve(std::max(neededOffsets, 2 * offsets.capacity()));
+    }
+    for (size_t i = 0; i < rowsToAdd.size(); i++) {
+        int length = rowsToAdd[i].length;
+        size_t at = chars.size();
+        chars.resize(at + length);
+        const char *source = ownStart[i] >= 0 ? chars.data() + ownStart[i]
+                                              : rowsToAdd[i].start;
+        if (length > 0) {
+            std::memcpy(chars.data() + at, source, length);
+        }
+        offsets.push_back(chars.size());
+    }
+}
+
+/*
+ * name:      clear
+ * purpose:   removes every row
+ * arguments: none
+ * returns:   none
+ * effects:   rows() is 0; the memory is kept for reuse
+ */
+void CharArrayListColumn::clear() {
+    chars.clear();
+    offsets.assign(1, 0);
+}
+
+/*
+ * name:      findRows
+ * purpose:   finds every row that contains a run of chars
+ * arguments: the chars to look for
+ * returns:   the rows holding the pattern, in increasing order
+ * effects:   none
+ */
+std::vector<int> CharArrayListColumn::findRows(
+    const CharArrayListView &pattern) const {
+    std::vector<int> found;
+    if (pattern.isEmpty()) {
+        for (int r = 0; r < rows(); r++) {
+            found.push_back(r);
+        }
+        return found;
+    }
+
+    // search the whole column as one run of chars, then throw out matches
+    // that start in one row and end in another
+    CharArrayListView all(chars.data(), totalSize());
+    int position = 0;
+    while (position <= totalSize()) {
+        int match = all.findSubsequence(pattern, position);
+        if (match < 0) {
+            break;
+        }
+        int row = std::upper_bound(offsets.begin(), offsets.end(), match) -
+                  offsets.begin() - 1;
+        if (match + pattern.size() <= offsets[row + 1]) {
+            // one match is enough, go on to the next row
+            found.push_back(row);
+            position = offsets[row + 1];
+        } else {
+            position = match + 1;
+        }
+    }
+    return found;
+}
+
+/*
+ * name:      filter
+ * purpose:   makes a column of the rows that pass a test
+ * arguments: a function that is given each row and returns true to keep it
+ * returns:   a new column with the kept rows, in order
+ * effects:   none
+ */
+CharArrayListColumn CharArrayListColumn::filter(
+    const std::function<bool(const CharArrayListView &)> &keep) const {
+    std::vector<CharArrayListView> kept;
+    for (int r = 0; r < rows(); r++) {
+        CharArrayListView row = view(r);
+        if (keep(row)) {
+            kept.push_back(row);
+        }
+    }
+    CharArrayListColumn result;
+    result.appendRows(kept);
+    return result;
+}
+
+/*
+ * name:      checkRow
+ * purpose:   makes sure a row exists
+ * arguments: the row
+ * returns:   none
+ * effects:   throws a range_error if it does not
+ */
+void CharArrayListColumn::checkRow(int row) const {
+    if (row >= rows() or row < 0) {
+        throw std::range_error( "row (" + std::to_string(row) +
+        ") not in range [0.." + std::to_string(rows()) + ")" );
+    }
+}
+
+/*
+ * name:      checkGrowth
+ * purpose:   makes sure the column can hold more chars
+ * arguments: how many chars are about to be added
+ * returns:   none
+ * effects:   throws a runtime_error if the total would not fit in an int
+ */
+void CharArrayListColumn::checkGrowth(long extra) const {
+    if (extra > INT_MAX - static_cast<long>(totalSize())) {
+        throw std::runtime_error("cannot grow CharArrayListColumn past "
+                                 "INT_MAX chars");
+    }
+}
@@ -0,0 +1,61 @@
+/*
+ *  CharArrayListColumn.h
+ *  Name: Leo Kim
+ *  Date: 10/19/2026
+ *
+ *  Purpose: Class declaration for the CharArrayListColumn class. A
+ *           CharArrayListColumn holds many rows, each a list of chars,
+ *           with every row's chars packed end to end in one array and an
+ *           array of offsets saying where each row starts. Scanning the
+ *           whole column reads memory in order instead of following a
+ *           pointer per row the way a vector of CharArrayLists does.
+ *
+ */
+#ifndef CHAR_ARRAY_LIST_COLUMN_H
+#define CHAR_ARRAY_LIST_COLUMN_H
+
+#include "CharArrayList.h"
+#include "CharArrayListView.h"
+#include "CharArrayAllocator.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+class CharArrayListColumn {
+public:
+    CharArrayListColumn();  // Default Constructor (no rows)
+
+    bool isEmpty() const;
+    int rows() const;
+    int totalSize() const;
+    int rowSize(int row) const;
+    char elementAt(int row, int index) const;
+    std::string toString(int row) const;
+    CharArrayListView view(int row) const;
+    CharArrayList materialize(int row) const;
+
+    void pushAtBack(int row, char c);
+    void appendRow(const CharArrayListView &chars);
+    void appendRow(const CharArrayList &list);
+    void appendRows(const std::vector<CharArrayListView> &rowsToAdd);
+    void clear();
+
+    std::vector<int> findRows(const CharArrayListView &pattern) const;
+    CharArrayListColumn filter(
+        const std::function<bool(const CharArrayListView &)> &keep) const;
+
+private:
+    // chars holds every row back to back; row r is
+    // chars[offsets[r] .. offsets[r + 1]), so offsets has rows() + 1 entries.
+    // The chars come from CharArrayAllocator, charged to the tag current
+    // when the column was made; the offsets are bookkeeping and are not
+    // counted
+    std::vector<char, CharArrayAllocator::ContainerAllocator> chars;
+    std::vector<int> offsets;
+
+    // helper functions
+    void checkRow(int row) const;
+    void checkGrowth(long extra) const;
+};
+
+#endif
@@ -0,0 +1,179 @@
+/*
+ *  CharArrayListConcat.cpp
+ *  Name: Leo Kim
+ *  Date: 10/19/2026
+ *
+ *  Purpose: Implementation of the CharArrayListConcat class. Pieces are
+ *           kept as CharArrayListViews, so everything appended must stay
+ *           alive and unchanged until the concatenation is flattened or
+ *           written out.
+ *
+ */
+
+#include "CharArrayListConcat.h"
+#include "CharArrayListWriter.h"
+#include <sys/uio.h>
+
+/*
+ * name:      CharArrayListConcat default constructor
+ * purpose:   initialize an empty concatenation
+ * arguments: none
+ * returns:   none
+ * effects:   there are no pieces
+ */
+CharArrayListConcat::CharArrayListConcat() {
+    total = 0;
+    flattened = false;
+}
+
+/*
+ * name:      append
+ * purpose:   adds a whole CharArrayList to the end
+ * arguments: the list, which is not copied
+ * returns:   none
+ * effects:   records the list as the last piece
+ */
+void CharArrayListConcat::append(const CharArrayList &list) {
+    append(list.slice(0, list.size()));
+}
+
+/*
+ * name:      append
+ * purpose:   adds a view to the end
+ * arguments: the view, whose chars are not copied
+ * returns:   none
+ * effects:   records the view as the last piece
+ */
+void CharArrayListConcat::append(const CharArrayListView &piece) {
+    if (piece.isEmpty()) {
+        return;
+    }
+    pieces.push_back(piece);
+    total += piece.size();
+    flattened = false;
+}
+
+/*
+ * name:      append
+ * purpose:   adds another concatenation to the end
+ * arguments: the other concatenation
+ * returns:   none
+ * effects:   records each of its pieces, without joining them. A
+ *            concatenation can be appended to itself
+ */
+void CharArrayListConcat::append(const CharArrayListConcat &other) {
+    int count = other.pieces.size();
+    for (int i = 0; i < count; i++) {
+        append(other.pieces[i]);
+    }
+}
+
+/*
+ * name:      isEmpty
+ * purpose:   determines if the concatenation is empty or not
+ * arguments: none
+ * returns:   true if there are no chars in any piece
+ * effects:   none
+ */
+bool CharArrayListConcat::isEmpty() const {
+    return total == 0;
+}
+
+/*
+ * name:      size
+ * purpose:   determine the number of chars in the concatenation
+ * arguments: none
+ * returns:   the sum of the sizes of the pieces
+ * effects:   none
+ */
+int CharArrayListConcat::size() const {
+    return total;
+}
+
+/*
+ * name:      pieceCount
+ * purpose:   determine how many pieces are recorded
+ * arguments: none
+ * returns:   the number of pieces (1 once flattened, unless empty)
+ * effects:   none
+ */
+int CharArrayListConcat::pieceCount() const {
+    return pieces.size();
+}
+
+/*
+ * name:      elementAt
+ * purpose:   determines the element at a given index
+ * arguments: index of element
+ * returns:   the element, or an error if the index is out of range
+ * effects:   flattens the concatenation
+ */
+char CharArrayListConcat::elementAt(int index) {
+    return flatten().elementAt(index);
+}
+
+/*
+ * name:      toString
+ * purpose:   Express the concatenation in a string
+ * arguments: none
+ * returns:   the string CharArrayList::toString gives for the joined list
+ * effects:   flattens the concatenation
+ */
+std::string CharArrayListConcat::toString() {
+    return flatten().toString();
+}
+
+/*
+ * name:      flatten
+ * purpose:   joins the pieces into one CharArrayList
+ * arguments: none
+ * returns:   the joined list, valid until the next append or build
+ * effects:   allocates the joined list once, at exactly the total size,
+ *            and from then on uses it as the only piece
+ */
+const CharArrayList &CharArrayListConcat::flatten() {
+    if (not flattened) {
+        // the joined list is built before the old flat list is replaced,
+        // since the first piece may be a view of it
+        flat = CharArrayList::join(pieces);
+        pieces.clear();
+        if (total > 0) {
+            pieces.push_back(flat.slice(0, flat.size()));
+        }
+        flattened = true;
+    }
+    return flat;
+}
+
+/*
+ * name:      build
+ * purpose:   joins the pieces and hands over the result
+ * arguments: none
+ * returns:   the joined CharArrayList
+ * effects:   the concatenation is left empty
+ */
+CharArrayList CharArrayListConcat::build() {
+    flatten();
+    CharArrayList result = std::move(flat);
+    pieces.clear();
+    total = 0;
+    flattened = false;
+    return result;
+}
+
+/*
+ * name:      writeTo
+ * purpose:   writes the concatenation to a file descriptor
+ * arguments: the file descriptor
+ * returns:   error message if writing fails
+ * effects:   writes every piece straight from where it lives with writev,
+ *            without joining them
+ */
+void CharArrayListConcat::writeTo(int fd) const {
+    std::vector<struct iovec> parts(pieces.size());
+    for (size_t i = 0; i < pieces.size(); i++) {
+        parts[i].iov_base = const_cast<char *>(pieces[i].start);
+        parts[i].iov_len = pieces[i].size();
+    }
+    CharArrayListWriter::writeAll(fd, parts);
+}
@@ -0,0 +1,51 @@
+/*
+ *  CharArrayListConcat.h
+ *  Name: Leo Kim
+ *  Date: 10/19/2026
+ *
+ *  Purpose: Class declaration for the CharArrayListConcat class. A
+ *           CharArrayListConcat is a deferred concatenation: it records the
+ *           pieces appended to it without copying them, and only builds one
+ *           CharArrayList out of them (with a single, exactly sized
+ *           allocation) when an element or the whole string is needed.
+ *           Written to a file descriptor, the pieces are never joined.
+ *
+ */
+#ifndef CHAR_ARRAY_LIST_CONCAT_H
+#define CHAR_ARRAY_LIST_CONCAT_H
+
+#include "CharArrayList.h"
+#include "CharArrayListView.h"
+#include <string>
+#include <vector>
+
+class CharArrayListConcat {
+public:
+    CharArrayListConcat();
+    // not copyable, since a flattened concatenation views its own list
+    CharArrayListConcat(const CharArrayListConcat &other) = delete;
+    CharArrayListConcat &operator=(const CharArrayListConcat &other) = delete;
+
+    void append(const CharArrayList &list);
+    void append(const CharArrayListView &piece);
+    void append(const CharArrayListConcat &other);
+
+    bool isEmpty() const;
+    int size() const;
+    int pieceCount() const;
+    char elementAt(int index);
+    std::string toString();
+    const CharArrayList &flatten();
+    CharArrayList build();
+    void writeTo(int fd) const;
+
+private:
+    // the pieces, in order, and the sum of their sizes. Once flattened,
+    // the only piece is a view of flat
+    std::vector<CharArrayListView> pieces;
+    int total;
+    CharArrayList flat;
+    bool flattened;
+};
+
+#endif
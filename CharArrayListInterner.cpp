@@ -0,0 +1,268 @@
+/*
+ *  CharArrayListInterner.cpp
+ *  Name: Leo Kim
+ *  Date: 10/19/2026
+ *
+ *  Purpose: Implementation of the CharArrayListInterner class. Entries are
+ *           found through an open addressing hash table keyed by the same
+ *           hash CharArrayList::hash computes, and their chars are copied
+ *           once into large arena blocks instead of an array each.
+ *
+ */
+
+#include "CharArrayListInterner.h"
+#include "CharArrayAllocator.h"
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+/*
+ * name:      CharArrayListInterner default constructor
+ * purpose:   initialize an empty interner
+ * arguments: none
+ * returns:   none
+ * effects:   nothing is interned and no arena block is allocated yet
+ */
+CharArrayListInterner::CharArrayListInterner() {
+    slots.assign(16, EMPTY_SLOT);
+    tag = CharArrayAllocator::currentTag();
+    blockUsed = BLOCK_SIZE;
+    totalBytes = 0;
+}
+
+/*
+ * name:      CharArrayListInterner destructor
+ * purpose:   free the arena
+ * arguments: none
+ * returns:   none
+ * effects:   gives every arena block back to CharArrayAllocator
+ */
+CharArrayListInterner::~CharArrayListInterner() {
+    for (const Block &block : blocks) {
+        CharArrayAllocator::release(block.chars, block.capacity, tag);
+    }
+}
+
+/*
+ * name:      intern
+ * purpose:   gets the handle of some chars, storing them if they are new
+ * arguments: the chars, which are copied if they have not been seen before
+ * returns:   the handle for the chars; the same chars always get the same
+ *            handle from one interner
+ * effects:   may add an entry and grow the arena or the table
+ */
+CharArrayListInterner::Handle CharArrayListInterner::intern(
+    const CharArrayListView &chars) {
+    uint64_t hash = chars.hash();
+    long slot = findSlot(chars, hash);
+    if (slots[slot] != EMPTY_SLOT) {
+        return slots[slot];
+    }
+    if (entries.size() >= EMPTY_SLOT) {
+        throw std::runtime_error("cannot intern more than 2^32 - 1 entries");
+    }
+
+    Handle handle = entries.size();
+    entries.push_back({ store(chars), chars.size(), hash });
+    slots[slot] = handle;
+    if (entries.size() * 2 > slots.size()) {
+        growTable();
+    }
+    return handle;
+}
+
+/*
+ * name:      intern
+ * purpose:   gets the handle of the contents of a CharArrayList
+ * arguments: the list
+ * returns:   the handle for its contents
+ * effects:   see intern above
+ */
+CharArrayListInterner::Handle CharArrayListInterner::intern(
+    const CharArrayList &list) {
+    return intern(list.slice(0, list.size()));
+}
+
+/*
+ * name:      contains
+ * purpose:   determines if some chars have been interned
+ * arguments: the chars
+ * returns:   true if interning them would give an existing handle
+ * effects:   none
+ */
+bool CharArrayListInterner::contains(const CharArrayListView &chars) const {
+    return slots[findSlot(chars, chars.hash())] != EMPTY_SLOT;
+}
+
+/*
+ * name:      count
+ * purpose:   determines how many distinct entries have been interned
+ * arguments: none
+ * returns:   the number of handles handed out
+ * effects:   none
+ */
+int CharArrayListInterner::count() const {
+    return entries.size();
+}
+
+/*
+ * name:      arenaBytes
+ * purpose:   determines how much memory the arena holds
+ * arguments: none
+ * returns:   the total size of the arena blocks, in bytes
+ * effects:   none
+ */
+long CharArrayListInterner::arenaBytes() const {
+    return totalBytes;
+}
+
+/*
+ * name:      size
+ * purpose:   determines the length of an interned entry
+ * arguments: its handle
+ * returns:   the number of chars in the entry
+ * effects:   throws a range_error for a handle this interner did not give
+ */
+int CharArrayListInterner::size(Handle handle) const {
+    checkHandle(handle);
+    return entries[handle].length;
+}
+
+/*
+ * name:      view
+ * purpose:   looks at the chars of an interned entry without copying them
+ * arguments: its handle
+ * returns:   a view that stays valid for as long as the interner lives
+ * effects:   throws a range_error for a handle this interner did not give
+ */
+CharArrayListView CharArrayListInterner::view(Handle handle) const {
+    checkHandle(handle);
+    return CharArrayListView(entries[handle].start, entries[handle].length);
+}
+
+/*
+ * name:      materialize
+ * purpose:   copies an interned entry into a CharArrayList that can change
+ * arguments: its handle
+ * returns:   a new CharArrayList with the entry's chars, allocated exactly
+ * effects:   throws a range_error for a handle this interner did not give
+ */
+CharArrayList CharArrayListInterner::materialize(Handle handle) const {
+    return CharArrayList::join({ view(handle) });
+}
+
+/*
+ * name:      findSlot
+ * purpose:   finds where some chars are, or would go, in the table
+ * arguments: the chars and their hash
+ * returns:   the index of the slot holding their handle, or of the empty
+ *            slot where it would be stored
+ * effects:   none
+ */
+long CharArrayListInterner::findSlot(const CharArrayListView &chars,
+                                     uint64_t hash) const {
+    unsigned long mask = slots.size() - 1;
+    unsigned long slot = hash & mask;
+    while (slots[slot] != EMPTY_SLOT) {
+        const Entry &entry = entries[slots[slot]];
+        // the full hash rules out almost every other entry before memcmp
+        if (entry.hash == hash and
+            CharArrayListView(entry.start, entry.length) == chars) {
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+/*
+ * name:      store
+ * purpose:   copies chars into the arena
+ * arguments: the chars
+ * returns:   where the copy starts (nullptr for no chars)
+ * effects:   may allocate a new arena block
+ */
+const char *CharArrayListInterner::store(const CharArrayListView &chars) {
+    int length = chars.size();
+    if (length == 0) {
+        return nullptr;
+    }
+
+    char *copy;
+    if (length > BLOCK_SIZE / 4) {
+        // a long run gets its own block, leaving the current one to fill
+        copy = addBlock(length);
+        // keep the open block last, so new chars keep going into it
+        if (blocks.size() > 1) {
+            std::swap(blocks[blocks.size() - 1], blocks[blocks.size() - 2]);
+        }
+    } else {
+        if (blockUsed + length > BLOCK_SIZE) {
+            addBlock(BLOCK_SIZE);
+            blockUsed = 0;
+        }
+        copy = blocks.back().chars + blockUsed;
+        blockUsed += length;
+    }
+    std::memcpy(copy, chars.start, length);
+    return copy;
+}
+
+/*
+ * name:      addBlock
+ * purpose:   adds a block to the arena
+ * arguments: its capacity
+ * returns:   the new block's chars
+ * effects:   the block is last in blocks. Throws CharArrayBudgetExceeded
+ *            (leaving the arena as it was) if it does not fit the budget
+ */
+char *CharArrayListInterner::addBlock(int capacity) {
+    char *chars = CharArrayAllocator::allocate(capacity, tag);
+    try {
+        blocks.push_back({ chars, capacity });
+    } catch (...) {
+        CharArrayAllocator::release(chars, capacity, tag);
+        throw;
+    }
+    totalBytes += capacity;
+    return chars;
+}
+
+/*
+ * name:      growTable
+ * purpose:   doubles the hash table
+ * arguments: none
+ * returns:   none
+ * effects:   reinserts every handle using the hashes saved in entries
+ */
+void CharArrayListInterner::growTable() {
+    std::vector<Handle> old;
+    old.swap(slots);
+    slots.assign(old.size() * 2, EMPTY_SLOT);
+    unsigned long mask = slots.size() - 1;
+    for (Handle handle : old) {
+        if (handle == EMPTY_SLOT) {
+            continue;
+        }
+        unsigned long slot = entries[handle].hash & mask;
+        while (slots[slot] != EMPTY_SLOT) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = handle;
+    }
+}
+
+/*
+ * name:      checkHandle
+ * purpose:   makes sure a handle belongs to this interner
+ * arguments: the handle
+ * returns:   none
+ * effects:   throws a range_error if it is not one that was handed out
+ */
+void CharArrayListInterner::checkHandle(Handle handle) const {
+    if (handle >= entries.size()) {
+        throw std::range_error("handle (" + std::to_string(handle) +
+        ") not in range [0.." + std::to_string(entries.size()) + ")");
+    }
+}
@@ -0,0 +1,81 @@
+/*
+ *  CharArrayListInterner.h
+ *  Name: Leo Kim
+ *  Date: 10/19/2026
+ *
+ *  Purpose: Class declaration for the CharArrayListInterner class. An
+ *           interner stores each distinct run of chars once, packed into a
+ *           shared arena, and hands out a 32-bit Handle for it. Interning
+ *           the same contents twice gives the same handle, so handles can be
+ *           compared for equality in O(1). Interned chars never change; to
+ *           edit one, materialize it into a CharArrayList of its own.
+ *
+ */
+#ifndef CHAR_ARRAY_LIST_INTERNER_H
+#define CHAR_ARRAY_LIST_INTERNER_H
+
+#include "CharArrayList.h"
+#include "CharArrayListView.h"
+#include <cstdint>
+#include <vector>
+
+class CharArrayListInterner {
+public:
+    typedef uint32_t Handle;
+
+    CharArrayListInterner();
+    ~CharArrayListInterner();
+    // not copyable, since views handed out point into the arena
+    CharArrayListInterner(const CharArrayListInterner &other) = delete;
+    CharArrayListInterner &operator=(const CharArrayListInterner &other)
+        = delete;
+
+    Handle intern(const CharArrayListView &chars);
+    Handle intern(const CharArrayList &list);
+    bool contains(const CharArrayListView &chars) const;
+    int count() const;
+    long arenaBytes() const;
+    int size(Handle handle) const;
+    CharArrayListView view(Handle handle) const;
+    CharArrayList materialize(Handle handle) const;
+
+private:
+    // where an interned run of chars lives in the arena
+    struct Entry {
+        const char *start;
+        int length;
+        uint64_t hash;
+    };
+
+    // entries, indexed by handle
+    std::vector<Entry> entries;
+
+    // open addressing table of handles, EMPTY_SLOT where unused. Its size
+    // is a power of two, kept at least twice the number of entries
+    std::vector<Handle> slots;
+    static constexpr Handle EMPTY_SLOT = UINT32_MAX;
+
+    // the arena: chars are packed into blocks that are never moved or
+    // freed before the interner is, so views of them stay valid. Runs
+    // longer than a quarter of a block get a block of their own. Blocks
+    // come from CharArrayAllocator, charged to the tag current when the
+    // interner was made
+    struct Block {
+        char *chars;
+        int capacity;
+    };
+    std::vector<Block> blocks;
+    int tag;
+    int blockUsed;
+    long totalBytes;
+    static const int BLOCK_SIZE = 1 << 16;
+
+    // helper functions
+    long findSlot(const CharArrayListView &chars, uint64_t hash) const;
+    const char *store(const CharArrayListView &chars);
+    char *addBlock(int capacity);
+    void growTable();
+    void checkHandle(Handle handle) const;
+};
+
+#endif
@@ -0,0 +1,229 @@
+/*
+ *  CharArrayListShared.cpp
+ *  Name: Leo Kim
+ *  Date: 10/19/2026
+ *
+ *  Purpose: Implementation of the CharArrayListShared class. All atomics
+ *           use sequentially consistent ordering: a reader records the
+ *           epoch before it loads the snapshot pointer, and the writer
+ *           swaps the pointer before it bumps the epoch and reads the
+ *           slots, so a snapshot retired in epoch E can only be held by
+ *           readers whose slot says E or less.
+ *
+ */
+
+#include "CharArrayListShared.h"
+#include <thread>
+
+// hands each thread the slot it tries first, so readers on different
+// threads usually claim a slot with a single compare and swap
+static std::atomic<int> nextReaderHint(0);
+
+/*
+ * name:      CharArrayListShared default constructor
+ * purpose:   initialize a shared list with an empty snapshot
+ * arguments: none
+ * returns:   none
+ * effects:   readers see an empty list until the first publish
+ */
+CharArrayListShared::CharArrayListShared()
+    : CharArrayListShared(CharArrayList()) {
+}
+
+/*
+ * name:      CharArrayListShared constructor
+ * purpose:   initialize a shared list from an existing list
+ * arguments: the list, which is copied into both the draft and the first
+ *            snapshot
+ * returns:   none
+ * effects:   none
+ */
+CharArrayListShared::CharArrayListShared(const CharArrayList &initial)
+    : working(initial) {
+    for (int i = 0; i < READER_SLOTS; i++) {
+        slots[i].epoch.store(0);
+    }
+    epoch.store(1);
+    CharArrayList *snapshot = new CharArrayList(initial);
+    snapshot->hash();
+    current.store(snapshot);
+}
+
+/*
+ * name:      CharArrayListShared destructor
+ * purpose:   frees the current snapshot and any retired ones
+ * arguments: none
+ * returns:   none
+ * effects:   there must be no ReadGuards left
+ */
+CharArrayListShared::~CharArrayListShared() {
+    delete current.load();
+    for (auto &entry : retired) {
+        delete entry.second;
+    }
+}
+
+/*
+ * name:      read
+ * purpose:   gets the latest published snapshot for reading
+ * arguments: none
+ * returns:   a guard giving const access to the snapshot; the snapshot
+ *            does not change or go away while the guard exists
+ * effects:   takes a reader slot until the guard is destroyed. With at
+ *            most READER_SLOTS guards alive this never waits; past that it
+ *            waits for a slot to free up
+ */
+CharArrayListShared::ReadGuard CharArrayListShared::read() const {
+    thread_local int hint = nextReaderHint.fetch_add(1) % READER_SLOTS;
+    uint64_t seen = epoch.load();
+    for (int i = hint;; i = (i + 1) % READER_SLOTS) {
+        uint64_t expected = 0;
+        if (slots[i].epoch.compare_exchange_strong(expected, seen)) {
+            return ReadGuard(&slots[i], current.load());
+        }
+        if (i == (hint + READER_SLOTS - 1) % READER_SLOTS) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+/*
+ * name:      draft
+ * purpose:   gives the writer the list to change
+ * arguments: none
+ * returns:   the draft, which readers do not see until publish is called
+ * effects:   only one thread may use the draft and publish
+ */
+CharArrayList &CharArrayListShared::draft() {
+    return working;
+}
+
+/*
+ * name:      publish
+ * purpose:   makes the draft visible to readers
+ * arguments: none
+ * returns:   none
+ * effects:   replaces the snapshot with a copy of the draft (readers that
+ *            already hold the old one keep it), then frees every replaced
+ *            snapshot no reader can still hold
+ */
+void CharArrayListShared::publish() {
+    CharArrayList *snapshot = new CharArrayList(working);
+    // fill the hash cache now, so readers do not each compute it
+    snapshot->hash();
+    const CharArrayList *old = current.exchange(snapshot);
+    retired.emplace_back(epoch.fetch_add(1), old);
+    reclaim();
+}
+
+/*
+ * name:      version
+ * purpose:   determines how many times the list has been published
+ * arguments: none
+ * returns:   the number of publish calls so far
+ * effects:   none
+ */
+uint64_t CharArrayListShared::version() const {
+    return epoch.load() - 1;
+}
+
+/*
+ * name:      retiredCount
+ * purpose:   determines how many replaced snapshots are still kept
+ * arguments: none
+ * returns:   the number of snapshots waiting for readers to let go of them
+ * effects:   none
+ */
+int CharArrayListShared::retiredCount() const {
+    return retired.size();
+}
+
+/*
+ * name:      reclaim
+ * purpose:   frees replaced snapshots that no reader can hold any more
+ * arguments: none
+ * returns:   none
+ * effects:   a snapshot replaced in epoch E is freed once every reader
+ *            slot is free or records an epoch after E
+ */
+void CharArrayListShared::reclaim() {
+    uint64_t oldest = UINT64_MAX;
+    for (int i = 0; i < READER_SLOTS; i++) {
+        uint64_t seen = slots[i].epoch.load();
+        if (seen != 0 and seen < oldest) {
+            oldest = seen;
+        }
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < retired.size(); i++) {
+        if (retired[i].first < oldest) {
+            delete retired[i].second;
+        } else {
+            retired[kept++] = retired[i];
+        }
+    }
+    retired.resize(kept);
+}
+
+/*
+ * name:      ReadGuard constructor
+ * purpose:   initialize a guard over a claimed slot
+ * arguments: the slot and the snapshot it protects
+ * returns:   none
+ * effects:   none
+ */
+CharArrayListShared::ReadGuard::ReadGuard(ReaderSlot *readerSlot,
+                                          const CharArrayList *list) {
+    slot = readerSlot;
+    snapshot = list;
+}
+
+/*
+ * name:      ReadGuard move constructor
+ * purpose:   hands a snapshot over to a new guard
+ * arguments: the guard giving it up
+ * returns:   none
+ * effects:   the other guard no longer protects anything
+ */
+CharArrayListShared::ReadGuard::ReadGuard(ReadGuard &&other) {
+    slot = other.slot;
+    snapshot = other.snapshot;
+    other.slot = nullptr;
+    other.snapshot = nullptr;
+}
+
+/*
+ * name:      ReadGuard destructor
+ * purpose:   lets go of the snapshot
+ * arguments: none
+ * returns:   none
+ * effects:   frees the reader slot, so the writer may free the snapshot
+ */
+CharArrayListShared::ReadGuard::~ReadGuard() {
+    if (slot != nullptr) {
+        slot->epoch.store(0);
+    }
+}
+
+/*
+ * name:      operator*
+ * purpose:   gets the snapshot
+ * arguments: none
+ * returns:   the snapshot, valid for the life of the guard
+ * effects:   none
+ */
+const CharArrayList &CharArrayListShared::ReadGuard::operator*() const {
+    return *snapshot;
+}
+
+/*
+ * name:      operator->
+ * purpose:   calls a const function on the snapshot
+ * arguments: none
+ * returns:   the snapshot, valid for the life of the guard
+ * effects:   none
+ */
+const CharArrayList *CharArrayListShared::ReadGuard::operator->() const {
+    return snapshot;
+}
@@ -0,0 +1,91 @@
+/*
+ *  CharArrayListShared.h
+ *  Name: Leo Kim
+ *  Date: 10/19/2026
+ *
+ *  Purpose: Class declaration for the CharArrayListShared class. A
+ *           CharArrayListShared lets one writer thread change a
+ *           CharArrayList while any number of reader threads read it
+ *           without taking a lock. The writer edits a private draft and
+ *           publishes it as a new immutable snapshot; readers always see
+ *           one whole snapshot. Old snapshots are freed once no reader can
+ *           still be looking at them (epoch based reclamation).
+ *
+ */
+#ifndef CHAR_ARRAY_LIST_SHARED_H
+#define CHAR_ARRAY_LIST_SHARED_H
+
+#include "CharArrayList.h"
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+class CharArrayListShared {
+private:
+    // one per concurrent reader: the epoch the reader saw when it started,
+    // or 0 while the slot is free. Each is on its own cache line so
+    // readers do not slow each other down
+    struct alignas(64) ReaderSlot {
+        std::atomic<uint64_t> epoch;
+    };
+
+public:
+    // Keeps one snapshot alive while it is read. Get one from read() and
+    // let it go out of scope when done; it must not outlive the
+    // CharArrayListShared it came from. Any const function may be called
+    // on the snapshot
+    class ReadGuard {
+    public:
+        ReadGuard(ReadGuard &&other);
+        ReadGuard(const ReadGuard &other) = delete;
+        ReadGuard &operator=(const ReadGuard &other) = delete;
+        ~ReadGuard();
+
+        const CharArrayList &operator*() const;
+        const CharArrayList *operator->() const;
+
+    private:
+        friend class CharArrayListShared;
+        ReadGuard(ReaderSlot *slot, const CharArrayList *snapshot);
+
+        ReaderSlot *slot;
+        const CharArrayList *snapshot;
+    };
+
+    CharArrayListShared();
+    CharArrayListShared(const CharArrayList &initial);
+    CharArrayListShared(const CharArrayListShared &other) = delete;
+    CharArrayListShared &operator=(const CharArrayListShared &other)
+        = delete;
+    ~CharArrayListShared();
+
+    // readers
+    ReadGuard read() const;
+
+    // the writer (only one thread at a time)
+    CharArrayList &draft();
+    void publish();
+    uint64_t version() const;
+    int retiredCount() const;
+
+    static const int READER_SLOTS = 64;
+
+private:
+    std::atomic<const CharArrayList *> current;
+    mutable ReaderSlot slots[READER_SLOTS];
+
+    // bumped by every publish; readers record it in their slot. Starts at
+    // 1 so that 0 can mean a free slot
+    std::atomic<uint64_t> epoch;
+
+    // writer-only state: the draft, and the snapshots replaced by
+    // publish, each with the epoch it was replaced in
+    CharArrayList working;
+    std::vector<std::pair<uint64_t, const CharArrayList *>> retired;
+
+    // helper functions
+    void reclaim();
+};
+
+#endif
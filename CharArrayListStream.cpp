@@ -0,0 +1,512 @@
+/*
+ *  CharArrayListStream.cpp
+ *  Name: Leo Kim
+ *  Date: 10/19/2026
+ *
+ *  Purpose: Implementation of the CharArrayListGenerator and
+ *           CharArrayListStream classes. Generators are pulled: nothing is
+ *           read or computed until the consumer asks for the next chunk,
+ *           except in prefetch, whose background thread works up to depth
+ *           chunks ahead. Putting prefetch between two stages lets them
+ *           run at the same time, for example
+ *
+ *               prefetch(transform(prefetch(readChunks(fd, n)), fn))
+ *
+ *           reads, transforms and consumes on three threads at once.
+ *
+ */
+
+#include "CharArrayListStream.h"
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+// unmaps a file mapping when the generator using it is destroyed
+struct Mapping {
+    void *address = MAP_FAILED;
+    size_t length = 0;
+
+    ~Mapping() {
+        if (address != MAP_FAILED) {
+            munmap(address, length);
+        }
+    }
+};
+
+// the buffers and queue shared by prefetch and its background thread.
+// Every buffer is always in exactly one place: free, being filled by the
+// producer, waiting in full, or held by the consumer
+struct PrefetchState {
+    std::mutex lock;
+    std::condition_variable changed;
+    std::vector<std::unique_ptr<CharArrayList>> buffers;
+    std::vector<CharArrayList *> free;
+    std::deque<CharArrayList *> full;
+    bool finished = false;      // the source has no more chunks
+    bool stopping = false;      // the consumer went away early
+    std::exception_ptr error;   // what the source threw, if anything
+    std::thread producer;
+
+    ~PrefetchState() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        changed.notify_all();
+        if (producer.joinable()) {
+            producer.join();
+        }
+    }
+};
+
+}
+
+/*
+ * name:      CharArrayListGenerator constructor
+ * purpose:   initialize a generator that owns a coroutine
+ * arguments: the coroutine, suspended before its first statement
+ * returns:   none
+ * effects:   none
+ */
+CharArrayListGenerator::CharArrayListGenerator(
+    std::coroutine_handle<promise_type> coroutine) {
+    handle = coroutine;
+}
+
+/*
+ * name:      CharArrayListGenerator move constructor
+ * purpose:   hands a coroutine over to a new generator
+ * arguments: the generator giving it up
+ * returns:   none
+ * effects:   the other generator is left with no chunks
+ */
+CharArrayListGenerator::CharArrayListGenerator(
+    CharArrayListGenerator &&other) {
+    handle = other.handle;
+    other.handle = nullptr;
+}
+
+/*
+ * name:      CharArrayListGenerator move assignment
+ * purpose:   replaces this generator's coroutine with another's
+ * arguments: the generator giving it up
+ * returns:   this generator
+ * effects:   destroys the old coroutine; the other generator is left with
+ *            no chunks
+ */
+CharArrayListGenerator &CharArrayListGenerator::operator=(
+    CharArrayListGenerator &&other) {
+    if (this != &other) {
+        if (handle) {
+            handle.destroy();
+        }
+        handle = other.handle;
+        other.handle = nullptr;
+    }
+    return *this;
+}
+
+/*
+ * name:      CharArrayListGenerator destructor
+ * purpose:   destroys the coroutine
+ * arguments: none
+ * returns:   none
+ * effects:   the coroutine's buffers, files and threads are cleaned up even
+ *            if it had more chunks to give
+ */
+CharArrayListGenerator::~CharArrayListGenerator() {
+    if (handle) {
+        handle.destroy();
+    }
+}
+
+/*
+ * name:      next
+ * purpose:   moves on to the next chunk
+ * arguments: none
+ * returns:   true if there is another chunk, false at the end
+ * effects:   runs the coroutine up to its next co_yield, which makes the
+ *            previous value() invalid. Anything the coroutine throws is
+ *            thrown from here, after which there are no more chunks
+ */
+bool CharArrayListGenerator::next() {
+    if (not handle or handle.done()) {
+        return false;
+    }
+    handle.resume();
+    if (handle.promise().error != nullptr) {
+        std::exception_ptr error = handle.promise().error;
+        handle.promise().error = nullptr;
+        std::rethrow_exception(error);
+    }
+    return not handle.done();
+}
+
+/*
+ * name:      value
+ * purpose:   looks at the current chunk
+ * arguments: none
+ * returns:   the chunk from the last next() that returned true, valid until
+ *            next() is called again or the generator is destroyed
+ * effects:   none
+ */
+const CharArrayListView &CharArrayListGenerator::value() const {
+    return handle.promise().current;
+}
+
+/*
+ * name:      readChunks
+ * purpose:   reads a file descriptor in chunks
+ * arguments: the file descriptor, read from its current position, and the
+ *            number of chars in each chunk
+ * returns:   a generator of chunkSize chunks, with a shorter last one
+ * effects:   the chunks all live in one buffer that is refilled each time,
+ *            so only one chunk is in memory at once. Throws a range_error if
+ *            chunkSize is not positive, and a runtime_error from next() if
+ *            reading fails
+ */
+CharArrayListGenerator CharArrayListStream::readChunks(int fd,
+                                                       int chunkSize) {
+    checkChunkSize(chunkSize);
+    return readLoop(fd, chunkSize);
+}
+
+/*
+ * name:      mapChunks
+ * purpose:   reads a whole file in chunks without copying it
+ * arguments: the file descriptor and the number of chars in each chunk
+ * returns:   a generator of views straight into a mapping of the file,
+ *            chunkSize chars each with a shorter last one
+ * effects:   maps the file (from the start, whatever the position of fd)
+ *            for as long as the generator runs and lets the OS read ahead.
+ *            A file descriptor that is not a regular file, such as a pipe,
+ *            is read as by readChunks instead. Throws a range_error if
+ *            chunkSize is not positive and a runtime_error if the file
+ *            cannot be mapped
+ */
+CharArrayListGenerator CharArrayListStream::mapChunks(int fd,
+                                                      int chunkSize) {
+    checkChunkSize(chunkSize);
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        throw std::runtime_error("cannot map file: " +
+                                 std::string(std::strerror(errno)));
+    }
+    if (not S_ISREG(info.st_mode)) {
+        return readLoop(fd, chunkSize);
+    }
+    return mapLoop(fd, chunkSize);
+}
+
+/*
+ * name:      chunksOf
+ * purpose:   hands out a list in chunks
+ * arguments: the list, which must outlive the generator and not change
+ *            while it runs, and the number of chars in each chunk
+ * returns:   a generator of views of the list, chunkSize chars each with a
+ *            shorter last one
+ * effects:   throws a range_error if chunkSize is not positive
+ */
+CharArrayListGenerator CharArrayListStream::chunksOf(const CharArrayList &list,
+                                                     int chunkSize) {
+    checkChunkSize(chunkSize);
+    return sliceLoop(list, chunkSize);
+}
+
+/*
+ * name:      transform
+ * purpose:   changes every chunk of a generator
+ * arguments: the generator, and a function that is given each chunk and an
+ *            empty output list to fill (with pushAtBack, concatenate and so
+ *            on) from it
+ * returns:   a generator of the output lists, skipping empty ones
+ * effects:   the output list is emptied and reused for every chunk, so once
+ *            its array is big enough nothing more is allocated. Runs fn on
+ *            the thread calling next(); wrap the result in prefetch to run
+ *            it in the background
+ */
+CharArrayListGenerator CharArrayListStream::transform(
+    CharArrayListGenerator source, Transform fn) {
+    return transformLoop(std::move(source), std::move(fn));
+}
+
+/*
+ * name:      prefetch
+ * purpose:   runs a generator ahead of its consumer on another thread
+ * arguments: the generator, and how many chunks it may get ahead by
+ * returns:   a generator of the same chunks in the same order
+ * effects:   a background thread pulls chunks from source and copies them
+ *            into depth + 1 buffers that are handed back and forth, so the
+ *            source works on the next chunks while the consumer is busy
+ *            with this one and memory stays bounded. Throws a range_error
+ *            if depth is not positive; what the source throws comes out of
+ *            next() once the chunks before it are used up
+ */
+CharArrayListGenerator CharArrayListStream::prefetch(
+    CharArrayListGenerator source, int depth) {
+    if (depth <= 0) {
+        throw std::range_error("prefetch depth must be positive");
+    }
+    return prefetchLoop(std::move(source), depth);
+}
+
+/*
+ * name:      append
+ * purpose:   adds every chunk of a generator to the end of a list
+ * arguments: the generator and the list to grow
+ * returns:   the number of chars appended
+ * effects:   runs the generator to the end. The list grows as
+ *            concatenate grows it, so appending n chars is O(n) amortized
+ */
+long CharArrayListStream::append(CharArrayListGenerator source,
+                                 CharArrayList &target) {
+    long appended = 0;
+    while (source.next()) {
+        const CharArrayListView &chunk = source.value();
+        chunk.check();
+        target.appendChars(chunk.start, chunk.length);
+        appended += chunk.length;
+    }
+    return appended;
+}
+
+/*
+ * name:      readLoop
+ * purpose:   the coroutine behind readChunks
+ * arguments: the file descriptor and a positive chunk size
+ * returns:   the generator
+ * effects:   see readChunks
+ */
+CharArrayListGenerator CharArrayListStream::readLoop(int fd, int chunkSize) {
+    CharArrayList chunk;
+    bool atEnd = false;
+    while (not atEnd) {
+        char *buffer = reuse(chunk, chunkSize);
+        int filled = 0;
+        // keep reading after short reads, so every chunk but the last is
+        // full even from a pipe
+        while (filled < chunkSize) {
+            ssize_t got = read(fd, buffer + filled, chunkSize - filled);
+            if (got < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::runtime_error("cannot read ArrayList chunk: " +
+                                         std::string(std::strerror(errno)));
+            }
+            if (got == 0) {
+                atEnd = true;
+                break;
+            }
+            filled += got;
+        }
+        if (filled > 0) {
+            chunk.numItems = filled;
+            co_yield chunk.slice(0, filled);
+        }
+    }
+}
+
+/*
+ * name:      mapLoop
+ * purpose:   the coroutine behind mapChunks
+ * arguments: the file descriptor of a regular file and a positive chunk
+ *            size
+ * returns:   the generator
+ * effects:   see mapChunks
+ */
+CharArrayListGenerator CharArrayListStream::mapLoop(int fd, int chunkSize) {
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        throw std::runtime_error("cannot map file: " +
+                                 std::string(std::strerror(errno)));
+    }
+    if (info.st_size == 0) {
+        co_return;
+    }
+
+    Mapping mapping;
+    mapping.length = info.st_size;
+    mapping.address = mmap(nullptr, mapping.length, PROT_READ, MAP_PRIVATE,
+                           fd, 0);
+    if (mapping.address == MAP_FAILED) {
+        throw std::runtime_error("cannot map file: " +
+                                 std::string(std::strerror(errno)));
+    }
+    madvise(mapping.address, mapping.length, MADV_SEQUENTIAL);
+
+    const char *chars = static_cast<const char *>(mapping.address);
+    for (long at = 0; at < info.st_size; at += chunkSize) {
+        int length = std::min(static_cast<long>(chunkSize),
+                              info.st_size - at);
+        co_yield CharArrayListView(chars + at, length);
+    }
+}
+
+/*
+ * name:      sliceLoop
+ * purpose:   the coroutine behind chunksOf
+ * arguments: the list and a positive chunk size
+ * returns:   the generator
+ * effects:   see chunksOf
+ */
+CharArrayListGenerator CharArrayListStream::sliceLoop(
+    const CharArrayList &list, int chunkSize) {
+    for (int at = 0; at < list.size(); at += chunkSize) {
+        co_yield list.slice(at, std::min(at + chunkSize, list.size()));
+    }
+}
+
+/*
+ * name:      transformLoop
+ * purpose:   the coroutine behind transform
+ * arguments: the source generator and the function
+ * returns:   the generator
+ * effects:   see transform
+ */
+CharArrayListGenerator CharArrayListStream::transformLoop(
+    CharArrayListGenerator source, Transform fn) {
+    CharArrayList out;
+    while (source.next()) {
+        reuse(out, 0);
+        fn(source.value(), out);
+        if (not out.isEmpty()) {
+            co_yield out.slice(0, out.size());
+        }
+    }
+}
+
+/*
+ * name:      prefetchLoop
+ * purpose:   the coroutine behind prefetch
+ * arguments: the source generator and a positive depth
+ * returns:   the generator
+ * effects:   see prefetch. Destroying the generator early stops the
+ *            background thread at its next chunk and waits for it
+ */
+CharArrayListGenerator CharArrayListStream::prefetchLoop(
+    CharArrayListGenerator source, int depth) {
+    PrefetchState state;
+    for (int i = 0; i <= depth; i++) {
+        state.buffers.push_back(std::make_unique<CharArrayList>());
+        state.free.push_back(state.buffers.back().get());
+    }
+
+    state.producer = std::thread([&state, &source]() {
+        try {
+            while (source.next()) {
+                CharArrayList *buffer;
+                {
+                    std::unique_lock<std::mutex> guard(state.lock);
+                    state.changed.wait(guard, [&state]() {
+                        return state.stopping or not state.free.empty();
+                    });
+                    if (state.stopping) {
+                        return;
+                    }
+                    buffer = state.free.back();
+                    state.free.pop_back();
+                }
+                // copy outside the lock, so the consumer is never held up
+                copyInto(*buffer, source.value());
+                {
+                    std::lock_guard<std::mutex> guard(state.lock);
+                    state.full.push_back(buffer);
+                }
+                state.changed.notify_all();
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> guard(state.lock);
+            state.error = std::current_exception();
+        }
+        {
+            std::lock_guard<std::mutex> guard(state.lock);
+            state.finished = true;
+        }
+        state.changed.notify_all();
+    });
+
+    CharArrayList *held = nullptr;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> guard(state.lock);
+            // the chunk handed out last time is done with, recycle it
+            if (held != nullptr) {
+                state.free.push_back(held);
+                held = nullptr;
+                state.changed.notify_all();
+            }
+            state.changed.wait(guard, [&state]() {
+                return state.finished or not state.full.empty();
+            });
+            if (state.full.empty()) {
+                if (state.error != nullptr) {
+                    std::rethrow_exception(state.error);
+                }
+                break;
+            }
+            held = state.full.front();
+            state.full.pop_front();
+        }
+        co_yield held->slice(0, held->size());
+    }
+}
+
+/*
+ * name:      reuse
+ * purpose:   empties a chunk buffer without giving up its array
+ * arguments: the buffer, and how many chars it must be able to hold
+ * returns:   the buffer's array, with room for at least size chars
+ * effects:   the buffer's size is 0; it only reallocates if it is too small
+ */
+char *CharArrayListStream::reuse(CharArrayList &chunk, int size) {
+    chunk.contentsChanged();
+    chunk.numItems = 0;
+    if (chunk.capacity < size) {
+        chunk.resize(size);
+    }
+    return chunk.data;
+}
+
+/*
+ * name:      copyInto
+ * purpose:   fills a chunk buffer with a copy of a view
+ * arguments: the buffer and the chars to copy
+ * returns:   none
+ * effects:   replaces the buffer's contents, reusing its array when it is
+ *            big enough
+ */
+void CharArrayListStream::copyInto(CharArrayList &chunk,
+                                   const CharArrayListView &from) {
+    from.check();
+    char *buffer = reuse(chunk, from.length);
+    if (from.length > 0) {
+        std::memcpy(buffer, from.start, from.length);
+    }
+    chunk.numItems = from.length;
+}
+
+/*
+ * name:      checkChunkSize
+ * purpose:   makes sure a chunk size makes sense
+ * arguments: the chunk size
+ * returns:   none
+ * effects:   throws a range_error if it is not positive
+ */
+void CharArrayListStream::checkChunkSize(int chunkSize) {
+    if (chunkSize <= 0) {
+        throw std::range_error("chunk size must be positive");
+    }
+}
@@ -0,0 +1,104 @@
+/*
+ *  CharArrayListStream.h
+ *  Name: Leo Kim
+ *  Date: 10/19/2026
+ *
+ *  Purpose: Class declarations for the CharArrayListGenerator and
+ *           CharArrayListStream classes. A CharArrayListGenerator is a C++20
+ *           coroutine that hands out the chunks of an input one at a time as
+ *           CharArrayListViews. CharArrayListStream makes generators that
+ *           read chunks from a file descriptor or a memory mapped file, and
+ *           stages that transform, prefetch on a background thread, or
+ *           append the chunks of another generator. Every stage keeps a
+ *           fixed number of chunk buffers and reuses them, so an input of
+ *           any length goes through in a bounded amount of memory.
+ *
+ */
+#ifndef CHAR_ARRAY_LIST_STREAM_H
+#define CHAR_ARRAY_LIST_STREAM_H
+
+#include "CharArrayList.h"
+#include "CharArrayListView.h"
+#include <coroutine>
+#include <exception>
+#include <functional>
+
+class CharArrayListGenerator {
+public:
+    // the coroutine plumbing: the body runs only when next() is called,
+    // and stops at each co_yield with the view it yielded
+    struct promise_type {
+        CharArrayListView current;
+        std::exception_ptr error;
+
+        CharArrayListGenerator get_return_object() {
+            return CharArrayListGenerator(
+                std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        std::suspend_always yield_value(const CharArrayListView &chunk) {
+            current = chunk;
+            return {};
+        }
+        void return_void() {}
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+
+    CharArrayListGenerator(CharArrayListGenerator &&other);
+    CharArrayListGenerator &operator=(CharArrayListGenerator &&other);
+    CharArrayListGenerator(const CharArrayListGenerator &other) = delete;
+    CharArrayListGenerator &operator=(const CharArrayListGenerator &other)
+        = delete;
+    ~CharArrayListGenerator();
+
+    bool next();
+    const CharArrayListView &value() const;
+
+private:
+    explicit CharArrayListGenerator(
+        std::coroutine_handle<promise_type> coroutine);
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+class CharArrayListStream {
+public:
+    typedef std::function<void(const CharArrayListView &, CharArrayList &)>
+        Transform;
+
+    // sources
+    static CharArrayListGenerator readChunks(int fd, int chunkSize);
+    static CharArrayListGenerator mapChunks(int fd, int chunkSize);
+    static CharArrayListGenerator chunksOf(const CharArrayList &list,
+                                           int chunkSize);
+
+    // stages
+    static CharArrayListGenerator transform(CharArrayListGenerator source,
+                                            Transform fn);
+    static CharArrayListGenerator prefetch(CharArrayListGenerator source,
+                                           int depth = 2);
+
+    // sinks
+    static long append(CharArrayListGenerator source, CharArrayList &target);
+
+private:
+    // the coroutine bodies; the public functions check their arguments
+    // first, so mistakes are reported when the pipeline is built rather
+    // than at the first next()
+    static CharArrayListGenerator readLoop(int fd, int chunkSize);
+    static CharArrayListGenerator mapLoop(int fd, int chunkSize);
+    static CharArrayListGenerator sliceLoop(const CharArrayList &list,
+                                            int chunkSize);
+    static CharArrayListGenerator transformLoop(
+        CharArrayListGenerator source, Transform fn);
+    static CharArrayListGenerator prefetchLoop(CharArrayListGenerator source,
+                                               int depth);
+
+    // helper functions
+    static char *reuse(CharArrayList &chunk, int size);
+    static void copyInto(CharArrayList &chunk, const CharArrayListView &from);
+    static void checkChunkSize(int chunkSize);
+};
+
+#endif
@@ -0,0 +1,296 @@
+/*
+ *  CharArrayListView.cpp
+ *  Name: Leo Kim
+ *  Date: 10/19/2026
+ *
+ *  Purpose: Implementation of the CharArrayListView and
+ *           CharArrayListTokenizer classes. A view is only a pointer and a
+ *           length; it is valid as long as the chars it looks at are not
+ *           moved or freed.
+ *
+ */
+
+#include "CharArrayListView.h"
+#include "CharArrayList.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+
+/*
+ * name:      CharArrayListView default constructor
+ * purpose:   initialize an empty view
+ * arguments: none
+ * returns:   none
+ * effects:   the view has size 0
+ */
+CharArrayListView::CharArrayListView() {
+    start = nullptr;
+    length = 0;
+    owner = nullptr;
+    generation = 0;
+}
+
+/*
+ * name:      CharArrayListView constructor
+ * purpose:   initialize a view of a run of chars
+ * arguments: pointer to the first char and the number of chars
+ * returns:   none
+ * effects:   the view reads the chars in place; nothing is copied
+ */
+CharArrayListView::CharArrayListView(const char *first, int size) {
+    start = first;
+    length = size;
+    owner = nullptr;
+    generation = 0;
+}
+
+/*
+ * name:      CharArrayListView list constructor
+ * purpose:   initialize a view of part of a CharArrayList
+ * arguments: the list, the index of the first element and one past the
+ *            last element (not checked; see CharArrayList::slice)
+ * returns:   none
+ * effects:   the view is valid until the list moves its chars to a new
+ *            array (expand, shrink, clear, ...) or is destroyed
+ */
+CharArrayListView::CharArrayListView(const CharArrayList &list, int begin,
+                                     int end) {
+    start = list.data + begin;
+    length = end - begin;
+    owner = &list;
+    generation = list.generation;
+}
+
+/*
+ * name:      check
+ * purpose:   catches views used after their list moved its chars
+ * arguments: none
+ * returns:   none
+ * effects:   fails an assert if the list has reallocated since the view
+ *            was made. Does nothing when NDEBUG is defined. The list must
+ *            still exist: a destroyed list is not detected
+ */
+void CharArrayListView::check() const {
+    assert(owner == nullptr or owner->generation == generation);
+}
+
+/*
+ * name:      isEmpty
+ * purpose:   determines if the view is empty or not
+ * arguments: none
+ * returns:   true if the view contains no elements, false otherwise
+ * effects:   none
+ */
+bool CharArrayListView::isEmpty() const {
+    return length == 0;
+}
+
+/*
+ * name:      size
+ * purpose:   determine the number of items in the view
+ * arguments: none
+ * returns:   number of elements the view looks at
+ * effects:   none
+ */
+int CharArrayListView::size() const {
+    return length;
+}
+
+/*
+ * name:      first
+ * purpose:   determines the first element of the view
+ * arguments: none
+ * returns:   the first element, or an error if the view is empty
+ * effects:   none
+ */
+char CharArrayListView::first() const {
+    check();
+    if (isEmpty()){
+        throw std::runtime_error("cannot get first of empty ArrayList");
+    }
+    return start[0];
+}
+
+/*
+ * name:      last
+ * purpose:   determines the last element of the view
+ * arguments: none
+ * returns:   the last element, or an error if the view is empty
+ * effects:   none
+ */
+char CharArrayListView::last() const {
+    check();
+    if (isEmpty()){
+        throw std::runtime_error("cannot get last of empty ArrayList");
+    }
+    return start[length - 1];
+}
+
+/*
+ * name:      elementAt
+ * purpose:   determines the element at a given index in the view
+ * arguments: index of element
+ * returns:   the corresponding element, or an error if the index is out of
+ *            range
+ * effects:   none
+ */
+char CharArrayListView::elementAt(int index) const {
+    check();
+    if (index >= length or index < 0){
+        throw std::range_error( "index (" + std::to_string(index) +
+        ") not in range [0.." + std::to_string(length) + ")" );
+    }
+    return start[index];
+}
+
+/*
+ * name:      toString
+ * purpose:   Express a view in a string
+ * arguments: none
+ * returns:   A string in the same form CharArrayList::toString uses
+ * effects:   none
+ */
+std::string CharArrayListView::toString() const {
+    check();
+    std::string s = "[CharArrayList of size " + std::to_string(length)
+                    + " <<";
+    s.append(start, length);
+    s += ">>]";
+    return s;
+}
+
+/*
+ * name:      slice
+ * purpose:   makes a view of part of this view
+ * arguments: the index of the first element and one past the last
+ * returns:   a view of elements [begin, end), or an error if the range is
+ *            out of order or out of range
+ * effects:   none; nothing is copied
+ */
+CharArrayListView CharArrayListView::slice(int begin, int end) const {
+    check();
+    if (begin > length or begin < 0){
+        throw std::range_error( "index (" + std::to_string(begin) +
+        ") not in range [0.." + std::to_string(length) + "]" );
+    }
+    if (end > length or end < begin){
+        throw std::range_error( "index (" + std::to_string(end) +
+        ") not in range [" + std::to_string(begin) + ".." +
+        std::to_string(length) + "]" );
+    }
+    CharArrayListView part = *this;
+    part.start = start + begin;
+    part.length = end - begin;
+    return part;
+}
+
+/*
+ * name:      findSubsequence
+ * purpose:   finds where another view's chars appear inside this view
+ * arguments: the view to look for and the index to start from
+ * returns:   index of the first match at or after start, or -1 if there is
+ *            none. An empty pattern matches at start. Error message if
+ *            start is out of range
+ * effects:   none
+ */
+int CharArrayListView::findSubsequence(const CharArrayListView &pattern,
+                                       int from) const {
+    check();
+    pattern.check();
+    if (from > length or from < 0) {
+        throw std::range_error( "index (" + std::to_string(from) +
+        ") not in range [0.." + std::to_string(length) + "]" );
+    }
+    return CharArrayList::search(start, length, pattern.start,
+                                 pattern.length, from);
+}
+
+/*
+ * name:      operator==
+ * purpose:   determines if two views look at the same chars
+ * arguments: the other view
+ * returns:   true if both views have the same size and elements
+ * effects:   none
+ */
+bool CharArrayListView::operator==(const CharArrayListView &other) const {
+    check();
+    other.check();
+    return length == other.length and
+           (length == 0 or std::memcmp(start, other.start, length) == 0);
+}
+
+/*
+ * name:      operator<=>
+ * purpose:   orders two views
+ * arguments: the other view
+ * returns:   the same ordering CharArrayList's operator<=> gives
+ * effects:   none
+ */
+std::strong_ordering CharArrayListView::operator<=>(
+    const CharArrayListView &other) const {
+    check();
+    other.check();
+    int shared = std::min(length, other.length);
+    int result = shared == 0 ? 0 : std::memcmp(start, other.start, shared);
+    if (result != 0) {
+        return result < 0 ? std::strong_ordering::less
+                          : std::strong_ordering::greater;
+    }
+    return length <=> other.length;
+}
+
+/*
+ * name:      hash
+ * purpose:   computes a hash of the viewed chars
+ * arguments: none
+ * returns:   the same hash CharArrayList::hash gives for the same chars
+ * effects:   none
+ */
+uint64_t CharArrayListView::hash() const {
+    check();
+    return CharArrayList::hashChars(start, length);
+}
+
+/*
+ * name:      CharArrayListTokenizer constructor
+ * purpose:   initialize a tokenizer over a CharArrayList
+ * arguments: the list to split, the delimiter, and whether to skip the
+ *            empty tokens between adjacent delimiters
+ * returns:   none
+ * effects:   the list must not change while tokens are being taken
+ */
+CharArrayListTokenizer::CharArrayListTokenizer(const CharArrayList &source,
+                                               char delimiter,
+                                               bool skipEmptyTokens) {
+    list = &source;
+    delim = delimiter;
+    skipEmpty = skipEmptyTokens;
+    position = 0;
+}
+
+/*
+ * name:      next
+ * purpose:   takes the next token
+ * arguments: the view to point at the token
+ * returns:   true if there was another token, false once all are taken
+ * effects:   moves past the token and its delimiter. A list with n
+ *            delimiters has n + 1 tokens, some of which may be empty
+ */
+bool CharArrayListTokenizer::next(CharArrayListView &token) {
+    int size = list->size();
+    while (position <= size) {
+        const void *hit = nullptr;
+        if (position < size) {
+            hit = std::memchr(list->data + position, delim, size - position);
+        }
+        int end = hit == nullptr ? size
+                                 : static_cast<const char *>(hit) - list->data;
+        token = CharArrayListView(*list, position, end);
+        position = end + 1;
+        if (not skipEmpty or not token.isEmpty()) {
+            return true;
+        }
+    }
+    return false;
+}
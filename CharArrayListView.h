@@ -0,0 +1,79 @@
+/*
+ *  CharArrayListView.h
+ *  Name: Leo Kim
+ *  Date: 10/19/2026
+ *
+ *  Purpose: Class declarations for the CharArrayListView and
+ *           CharArrayListTokenizer classes. A CharArrayListView is a
+ *           read-only window onto chars owned by something else (usually a
+ *           CharArrayList), so pieces of a list can be passed around
+ *           without copying them. A CharArrayListTokenizer hands out the
+ *           pieces of a list between delimiters one at a time.
+ *
+ */
+#ifndef CHAR_ARRAY_LIST_VIEW_H
+#define CHAR_ARRAY_LIST_VIEW_H
+
+#include <compare>
+#include <cstdint>
+#include <string>
+
+class CharArrayList;
+
+class CharArrayListView {
+public:
+    CharArrayListView();    // Default Constructor (an empty view)
+    CharArrayListView(const char *start, int size);
+    CharArrayListView(const CharArrayList &list, int begin, int end);
+
+    bool isEmpty() const;
+    int size() const;
+    char first() const;
+    char last() const;
+    char elementAt(int index) const;
+    std::string toString() const;
+    CharArrayListView slice(int begin, int end) const;
+    int findSubsequence(const CharArrayListView &pattern,
+                        int start = 0) const;
+    bool operator==(const CharArrayListView &other) const;
+    std::strong_ordering operator<=>(const CharArrayListView &other) const;
+    uint64_t hash() const;
+
+private:
+    // these copy or write straight from the viewed chars
+    friend class CharArrayList;
+    friend class CharArrayListConcat;
+    friend class CharArrayListInterner;
+    friend class CharArrayListColumn;
+    friend class CharArrayListStream;
+
+    const char *start;
+    int length;
+
+    // the list the chars belong to (nullptr if none) and its generation
+    // when the view was made. Unless NDEBUG is defined, using a view after
+    // the list has moved its chars to a new array fails an assert. Only
+    // such moves are detected: the check reads the list itself, so using
+    // a view after its list is destroyed is undefined, not caught
+    const CharArrayList *owner;
+    unsigned int generation;
+
+    // helper functions
+    void check() const;
+};
+
+class CharArrayListTokenizer {
+public:
+    CharArrayListTokenizer(const CharArrayList &list, char delim,
+                           bool skipEmpty = false);
+
+    bool next(CharArrayListView &token);
+
+private:
+    const CharArrayList *list;
+    char delim;
+    bool skipEmpty;
+    int position;   // where the next token starts, past the end when done
+};
+
+#endif
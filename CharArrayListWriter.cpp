@@ -0,0 +1,246 @@
+/*
+ *  CharArrayListWriter.cpp
+ *  Name: Leo Kim
+ *  Date: 10/19/2026
+ *
+ *  Purpose: Implementation of the CharArrayListWriter class. Submitted
+ *           lists wait in one queue; each worker takes every queued list
+ *           for a file descriptor no other worker is writing to and hands
+ *           them all to writev at once.
+ *
+ */
+
+#include "CharArrayListWriter.h"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+#include <unistd.h>
+
+/*
+ * name:      CharArrayListWriter constructor
+ * purpose:   starts the background writer threads
+ * arguments: the number of threads, and how many chars may be queued
+ *            before submit waits for the writers to catch up
+ * returns:   none
+ * effects:   starts numThreads threads (at least one)
+ */
+CharArrayListWriter::CharArrayListWriter(int numThreads,
+                                         long maxQueuedBytes) {
+    maxQueued = maxQueuedBytes;
+    queued = 0;
+    writing = 0;
+    stopping = false;
+    if (numThreads < 1) {
+        numThreads = 1;
+    }
+    for (int i = 0; i < numThreads; i++) {
+        workers.emplace_back(&CharArrayListWriter::work, this);
+    }
+}
+
+/*
+ * name:      CharArrayListWriter destructor
+ * purpose:   stops the background writer threads
+ * arguments: none
+ * returns:   none
+ * effects:   writes everything still queued, then joins the threads
+ */
+CharArrayListWriter::~CharArrayListWriter() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (size_t i = 0; i < workers.size(); i++) {
+        workers[i].join();
+    }
+}
+
+/*
+ * name:      submit
+ * purpose:   queues a CharArrayList to be written
+ * arguments: the file descriptor to write to and the list, which is moved
+ *            in rather than copied
+ * returns:   a future that is ready once the chars are written, holding a
+ *            runtime_error if writing failed
+ * effects:   waits first if more than the limit of chars is queued (a list
+ *            larger than the limit is accepted once the queue is empty)
+ */
+std::future<void> CharArrayListWriter::submit(int fd, CharArrayList &&list) {
+    long size = list.size();
+    std::unique_lock<std::mutex> guard(lock);
+    roomAvailable.wait(guard, [this, size] {
+        return queued == 0 or queued + size <= maxQueued;
+    });
+
+    jobs.push_back(Job{fd, std::move(list), std::promise<void>()});
+    std::future<void> result = jobs.back().done.get_future();
+    queued += size;
+    guard.unlock();
+    workAvailable.notify_one();
+    return result;
+}
+
+/*
+ * name:      submit
+ * purpose:   queues a snapshot of a CharArrayList to be written
+ * arguments: the file descriptor to write to and the list to copy
+ * returns:   a future that is ready once the chars are written
+ * effects:   the list can be changed right away; see the other submit
+ */
+std::future<void> CharArrayListWriter::submit(int fd,
+                                              const CharArrayList &list) {
+    return submit(fd, CharArrayList(list));
+}
+
+/*
+ * name:      queuedBytes
+ * purpose:   determines how much is waiting to be written
+ * arguments: none
+ * returns:   the number of chars submitted but not yet written
+ * effects:   none
+ */
+long CharArrayListWriter::queuedBytes() {
+    std::lock_guard<std::mutex> guard(lock);
+    return queued;
+}
+
+/*
+ * name:      flush
+ * purpose:   waits for everything submitted so far to be written
+ * arguments: none
+ * returns:   none
+ * effects:   blocks until the queue is empty and no write is in progress
+ */
+void CharArrayListWriter::flush() {
+    std::unique_lock<std::mutex> guard(lock);
+    roomAvailable.wait(guard, [this] {
+        return jobs.empty() and writing == 0;
+    });
+}
+
+/*
+ * name:      work
+ * purpose:   the loop each background thread runs
+ * arguments: none
+ * returns:   none
+ * effects:   repeatedly takes all queued lists for one idle file descriptor
+ *            and writes them, until stopped with nothing left to write
+ */
+void CharArrayListWriter::work() {
+    std::unique_lock<std::mutex> guard(lock);
+    while (true) {
+        // find the oldest list whose file descriptor nobody is writing to
+        std::deque<Job>::iterator next = jobs.begin();
+        while (next != jobs.end() and busy.count(next->fd) != 0) {
+            ++next;
+        }
+        if (next == jobs.end()) {
+            if (stopping and jobs.empty()) {
+                return;
+            }
+            workAvailable.wait(guard);
+            continue;
+        }
+
+        // take it and every later list for the same file descriptor
+        int fd = next->fd;
+        std::vector<Job> batch;
+        long size = 0;
+        for (std::deque<Job>::iterator it = next; it != jobs.end(); ) {
+            if (it->fd == fd and batch.size() < IOV_MAX) {
+                size += it->list.size();
+                batch.push_back(std::move(*it));
+                it = jobs.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        busy.insert(fd);
+        writing += batch.size();
+
+        guard.unlock();
+        writeBatch(batch);
+        guard.lock();
+
+        busy.erase(fd);
+        writing -= batch.size();
+        queued -= size;
+        roomAvailable.notify_all();
+        // lists for this file descriptor may have queued up meanwhile
+        workAvailable.notify_one();
+    }
+}
+
+/*
+ * name:      writeBatch
+ * purpose:   writes a batch of lists bound for one file descriptor
+ * arguments: the batch, in submission order
+ * returns:   none
+ * effects:   writes the chars of every list, straight from their arrays,
+ *            and completes each list's future, with whatever exception
+ *            stopped the batch if it failed
+ */
+void CharArrayListWriter::writeBatch(std::vector<Job> &batch) {
+    // every future must complete, whatever goes wrong, or its waiter
+    // blocks forever
+    size_t completed = 0;
+    try {
+        std::vector<struct iovec> parts;
+        for (size_t i = 0; i < batch.size(); i++) {
+            if (not batch[i].list.isEmpty()) {
+                struct iovec part;
+                part.iov_base = batch[i].list.data;
+                part.iov_len = batch[i].list.size();
+                parts.push_back(part);
+            }
+        }
+        writeAll(batch[0].fd, parts);
+
+        for (; completed < batch.size(); completed++) {
+            batch[completed].done.set_value();
+        }
+    }
+    catch (...) {
+        for (; completed < batch.size(); completed++) {
+            batch[completed].done.set_exception(std::current_exception());
+        }
+    }
+}
+
+/*
+ * name:      writeAll
+ * purpose:   writes a list of buffers to a file descriptor
+ * arguments: the file descriptor and the buffers, in order
+ * returns:   error message if writing fails
+ * effects:   calls writev until everything is written, at most IOV_MAX
+ *            buffers at a time. The buffer list is used up in the process
+ */
+void CharArrayListWriter::writeAll(int fd, std::vector<struct iovec> &parts) {
+    // keep going after partial writes
+    size_t first = 0;
+    while (first < parts.size()) {
+        int count = std::min(parts.size() - first,
+                             static_cast<size_t>(IOV_MAX));
+        ssize_t written = writev(fd, parts.data() + first, count);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("cannot write ArrayList: " +
+                                     std::string(std::strerror(errno)));
+        }
+        while (first < parts.size() and
+               static_cast<size_t>(written) >= parts[first].iov_len) {
+            written -= parts[first].iov_len;
+            first++;
+        }
+        if (first < parts.size()) {
+            parts[first].iov_base =
+                static_cast<char *>(parts[first].iov_base) + written;
+            parts[first].iov_len -= written;
+        }
+    }
+}
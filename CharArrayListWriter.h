@@ -0,0 +1,62 @@
+/*
+ *  CharArrayListWriter.h
+ *  Name: Leo Kim
+ *  Date: 10/19/2026
+ *
+ *  Purpose: Class declaration for the CharArrayListWriter class. A
+ *           CharArrayListWriter writes the contents of CharArrayLists to
+ *           file descriptors on background threads, so the threads that
+ *           build the lists do not wait on the disk. Lists queued for the
+ *           same file descriptor are written in the order they were
+ *           submitted, several at a time with a single writev.
+ *
+ */
+#ifndef CHAR_ARRAY_LIST_WRITER_H
+#define CHAR_ARRAY_LIST_WRITER_H
+
+#include "CharArrayList.h"
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+#include <sys/uio.h>
+
+class CharArrayListWriter {
+public:
+    CharArrayListWriter(int numThreads = 1, long maxQueuedBytes = 1L << 26);
+    ~CharArrayListWriter();
+
+    std::future<void> submit(int fd, CharArrayList &&list);
+    std::future<void> submit(int fd, const CharArrayList &list);
+    long queuedBytes();
+    void flush();
+
+    static void writeAll(int fd, std::vector<struct iovec> &parts);
+
+private:
+    struct Job {
+        int fd;
+        CharArrayList list;
+        std::promise<void> done;
+    };
+
+    long maxQueued;
+    long queued;            // chars submitted but not yet written
+    int writing;            // jobs taken by a worker but not yet finished
+    bool stopping;
+    std::deque<Job> jobs;
+    std::set<int> busy;     // file descriptors a worker is writing to
+    std::mutex lock;
+    std::condition_variable workAvailable;
+    std::condition_variable roomAvailable;
+    std::vector<std::thread> workers;
+
+    // helper functions
+    void work();
+    static void writeBatch(std::vector<Job> &batch);
+};
+
+#endif
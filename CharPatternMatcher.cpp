@@ -0,0 +1,230 @@
+/*
+ *  CharPatternMatcher.cpp
+ *  Name: Leo Kim
+ *  Date: 10/19/2026
+ *
+ *  Purpose: Implementation of the CharPatternMatcher class. Patterns are
+ *           compiled into an Aho-Corasick automaton whose goto and failure
+ *           transitions are folded into one flat table, so scanning costs a
+ *           single table lookup per char and never allocates.
+ *
+ */
+
+#include "CharPatternMatcher.h"
+#include <stdexcept>
+
+/*
+ * name:      CharPatternMatcher default constructor
+ * purpose:   initialize a matcher with no patterns
+ * arguments: none
+ * returns:   none
+ * effects:   the matcher is empty and at the start of a stream
+ */
+CharPatternMatcher::CharPatternMatcher() {
+    compiled = false;
+    numClasses = 0;
+    state = 0;
+    position = 0;
+}
+
+/*
+ * name:      addPattern
+ * purpose:   adds a pattern to the dictionary
+ * arguments: the CharArrayList to look for
+ * returns:   the id reported for matches of this pattern, or an error if
+ *            the pattern is empty
+ * effects:   the matcher is recompiled and restarted by the next feed/scan
+ */
+int CharPatternMatcher::addPattern(const CharArrayList &pattern) {
+    if (pattern.isEmpty()) {
+        throw std::runtime_error("cannot add an empty pattern");
+    }
+
+    std::string s;
+    s.reserve(pattern.size());
+    for (int i = 0; i < pattern.size(); i++) {
+        s += pattern.elementAt(i);
+    }
+    patterns.push_back(s);
+    compiled = false;
+    return patterns.size() - 1;
+}
+
+/*
+ * name:      patternCount
+ * purpose:   determine the number of patterns in the dictionary
+ * arguments: none
+ * returns:   the number of patterns added so far
+ * effects:   none
+ */
+int CharPatternMatcher::patternCount() const {
+    return patterns.size();
+}
+
+/*
+ * name:      addState
+ * purpose:   adds a state with no transitions to the automaton
+ * arguments: none
+ * returns:   the new state
+ * effects:   grows the transition and output tables by one state
+ */
+int CharPatternMatcher::addState() {
+    int s = firstPattern.size();
+    transitions.resize(transitions.size() + numClasses, -1);
+    firstPattern.push_back(-1);
+    outputLink.push_back(-1);
+    return s;
+}
+
+/*
+ * name:      compile
+ * purpose:   builds the automaton for the current dictionary
+ * arguments: none
+ * returns:   none
+ * effects:   rebuilds every table and restarts the stream
+ */
+void CharPatternMatcher::compile() {
+    // give every char used by a pattern its own column, and every other
+    // char the shared column 0
+    for (int c = 0; c < 256; c++) {
+        charClass[c] = 0;
+    }
+    for (size_t p = 0; p < patterns.size(); p++) {
+        for (size_t i = 0; i < patterns[p].size(); i++) {
+            charClass[static_cast<unsigned char>(patterns[p][i])] = 1;
+        }
+    }
+    numClasses = 1;
+    for (int c = 0; c < 256; c++) {
+        if (charClass[c] != 0) {
+            charClass[c] = numClasses++;
+        }
+    }
+
+    // build the trie of all the patterns
+    transitions.clear();
+    firstPattern.clear();
+    outputLink.clear();
+    nextPattern.assign(patterns.size(), -1);
+    addState();
+    for (size_t p = 0; p < patterns.size(); p++) {
+        int s = 0;
+        for (size_t i = 0; i < patterns[p].size(); i++) {
+            int col = charClass[static_cast<unsigned char>(patterns[p][i])];
+            if (transitions[s * numClasses + col] == -1) {
+                int t = addState();
+                transitions[s * numClasses + col] = t;
+            }
+            s = transitions[s * numClasses + col];
+        }
+        // chain the pattern onto the state, keeping ids in order
+        if (firstPattern[s] == -1) {
+            firstPattern[s] = p;
+        } else {
+            int q = firstPattern[s];
+            while (nextPattern[q] != -1) {
+                q = nextPattern[q];
+            }
+            nextPattern[q] = p;
+        }
+    }
+
+    // breadth first, fill in each missing transition with the one its
+    // failure state takes, and link each state to its nearest suffix state
+    // that ends a pattern
+    int numStates = firstPattern.size();
+    std::vector<int> fail(numStates, 0);
+    std::vector<int> queue;
+    queue.reserve(numStates);
+    for (int col = 0; col < numClasses; col++) {
+        int t = transitions[col];
+        if (t == -1) {
+            transitions[col] = 0;
+        } else {
+            queue.push_back(t);
+        }
+    }
+    for (size_t head = 0; head < queue.size(); head++) {
+        int s = queue[head];
+        int f = fail[s];
+        outputLink[s] = firstPattern[f] != -1 ? f : outputLink[f];
+        for (int col = 0; col < numClasses; col++) {
+            int t = transitions[s * numClasses + col];
+            if (t == -1) {
+                transitions[s * numClasses + col] =
+                    transitions[f * numClasses + col];
+            } else {
+                fail[t] = transitions[f * numClasses + col];
+                queue.push_back(t);
+            }
+        }
+    }
+
+    compiled = true;
+    reset();
+}
+
+/*
+ * name:      reset
+ * purpose:   starts a new stream
+ * arguments: none
+ * returns:   none
+ * effects:   forgets any partial match and sets the stream position to 0
+ */
+void CharPatternMatcher::reset() {
+    state = 0;
+    position = 0;
+}
+
+/*
+ * name:      feed
+ * purpose:   scans the next chunk of a stream
+ * arguments: the next CharArrayList of the stream and the function to call
+ *            for each match
+ * returns:   the number of matches reported for this chunk
+ * effects:   advances the stream; matches may start in an earlier chunk
+ */
+int CharPatternMatcher::feed(const CharArrayList &chunk,
+                             const MatchCallback &onMatch) {
+    if (not compiled) {
+        compile();
+    }
+
+    int count = 0;
+    int s = state;
+    const int *table = transitions.data();
+    for (int i = 0; i < chunk.size(); i++) {
+        unsigned char c = chunk[i];
+        s = table[s * numClasses + charClass[c]];
+
+        // report every pattern ending here, walking the suffix links
+        int t = firstPattern[s] != -1 ? s : outputLink[s];
+        while (t != -1) {
+            for (int p = firstPattern[t]; p != -1; p = nextPattern[p]) {
+                onMatch(p, position + i + 1 - patterns[p].size());
+                count++;
+            }
+            t = outputLink[t];
+        }
+    }
+    state = s;
+    position += chunk.size();
+    return count;
+}
+
+/*
+ * name:      scan
+ * purpose:   finds every match in a single CharArrayList
+ * arguments: the CharArrayList to search and the function to call for each
+ *            match
+ * returns:   the number of matches
+ * effects:   restarts the stream before scanning
+ */
+int CharPatternMatcher::scan(const CharArrayList &text,
+                             const MatchCallback &onMatch) {
+    if (not compiled) {
+        compile();
+    }
+    reset();
+    return feed(text, onMatch);
+}
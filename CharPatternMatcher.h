@@ -0,0 +1,56 @@
+/*
+ *  CharPatternMatcher.h
+ *  Name: Leo Kim
+ *  Date: 10/19/2026
+ *
+ *  Purpose: Class declaration for the CharPatternMatcher class. A
+ *           CharPatternMatcher holds a dictionary of patterns and finds
+ *           every occurrence of all of them in a CharArrayList in a single
+ *           pass (Aho-Corasick). Text can be fed in one list at a time, so
+ *           matches that span two chunks are still found.
+ *
+ */
+#ifndef CHAR_PATTERN_MATCHER_H
+#define CHAR_PATTERN_MATCHER_H
+
+#include "CharArrayList.h"
+#include <functional>
+#include <vector>
+
+class CharPatternMatcher {
+public:
+    // called once per match with the id returned by addPattern and the
+    // index in the stream where the match starts
+    typedef std::function<void(int patternId, int position)> MatchCallback;
+
+    CharPatternMatcher();
+
+    int addPattern(const CharArrayList &pattern);
+    int patternCount() const;
+    void compile();
+    void reset();
+    int feed(const CharArrayList &chunk, const MatchCallback &onMatch);
+    int scan(const CharArrayList &text, const MatchCallback &onMatch);
+
+private:
+    std::vector<std::string> patterns;
+    bool compiled;
+
+    // the automaton, flattened into one table of numClasses entries per
+    // state. Chars that appear in no pattern share a single column
+    int numClasses;
+    int charClass[256];
+    std::vector<int> transitions;
+    std::vector<int> firstPattern;  // first pattern ending at a state, or -1
+    std::vector<int> nextPattern;   // next pattern ending at the same state
+    std::vector<int> outputLink;    // nearest suffix state with a pattern
+
+    // where the stream currently is
+    int state;
+    int position;
+
+    // helper functions
+    int addState();
+};
+
+#endif
@@ -0,0 +1,172 @@
+/*
+ *  benchmarks.cpp
+ *  Name: Leo Kim
+ *  Date: 10/19/2026
+ *
+ *  Purpose: Throughput benchmarks for the long scans and copies of
+ *           CharArrayList on lists of several MB, run once with the packed
+ *           layout and once with the aligned layout (see setAligned) so the
+ *           two can be compared. Building with
+ *           -DCHAR_ARRAY_LIST_NO_PREFETCH leaves out the software prefetch
+ *           hints, so running both builds measures what the hints are
+ *           worth.
+ *
+ *           Usage: ./benchmark [list size in MB, default 64]
+ *
+ */
+
+#include "CharArrayList.h"
+#include "CharArrayListView.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+// keeps results alive so the compiler cannot drop the work that made them
+static volatile long sink;
+
+/*
+ * name:      makeList
+ * purpose:   builds a list to benchmark on
+ * arguments: its size and whether it uses the aligned layout
+ * returns:   a list of n mostly lowercase letters with some digits and
+ *            spaces, the kind of text the scans are meant for
+ * effects:   none
+ */
+static CharArrayList makeList(int n, bool aligned) {
+    CharArrayList list;
+    list.setAligned(aligned);
+    std::string s(n, 'a');
+    for (int i = 0; i < n; i++) {
+        int r = (i * 7) % 31;
+        s[i] = r < 26 ? 'a' + r : r < 29 ? '0' + r : ' ';
+    }
+    CharArrayList built(&s[0], n);
+    list = built;
+    return list;
+}
+
+/*
+ * name:      bestOf
+ * purpose:   times an operation, filtering out noise
+ * arguments: the operation, which runs once per call
+ * returns:   the fewest seconds one run took out of at least 3, and more
+ *            (up to 50) until half a second has gone by
+ * effects:   runs the operation
+ */
+static double bestOf(const std::function<void()> &operation) {
+    double best = 1e30;
+    auto start = std::chrono::steady_clock::now();
+    for (int run = 0; run < 50; run++) {
+        auto before = std::chrono::steady_clock::now();
+        operation();
+        std::chrono::duration<double> took =
+            std::chrono::steady_clock::now() - before;
+        best = std::min(best, took.count());
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        if (run >= 2 and elapsed.count() >= 0.5) {
+            break;
+        }
+    }
+    return std::max(best, 1e-9);
+}
+
+/*
+ * name:      report
+ * purpose:   benchmarks one operation in both layouts and prints a row
+ * arguments: the operation's name, the list size, and the operation, which
+ *            is given a list in the layout being measured
+ * returns:   none
+ * effects:   prints MB/s for each layout and how much faster aligned is
+ */
+static void report(const std::string &name, int n,
+                   const std::function<void(CharArrayList &)> &operation) {
+    double seconds[2];
+    for (int aligned = 0; aligned < 2; aligned++) {
+        CharArrayList list = makeList(n, aligned);
+        seconds[aligned] = bestOf([&]() { operation(list); });
+    }
+    double megabytes = n / 1e6;
+    std::printf("%-22s %10.0f %10.0f %+8.1f%%\n", name.c_str(),
+                megabytes / seconds[0], megabytes / seconds[1],
+                (seconds[0] / seconds[1] - 1) * 100);
+}
+
+int main(int argc, char *argv[]) {
+    int megabytes = argc > 1 ? std::atoi(argv[1]) : 64;
+    if (megabytes < 1 or megabytes > 1024) {
+        std::fprintf(stderr, "list size must be in [1..1024] MB\n");
+        return 1;
+    }
+    int n = megabytes << 20;
+
+#ifdef CHAR_ARRAY_LIST_NO_PREFETCH
+    const char *hints = "without";
+#else
+    const char *hints = "with";
+#endif
+    std::printf("%d MB lists, %s prefetch hints\n", megabytes, hints);
+    std::printf("%-22s %10s %10s %9s\n", "operation", "packed", "aligned",
+                "gain");
+
+    // scans
+    report("countIf", n, [](CharArrayList &list) {
+        sink = list.countIf(CharArrayList::ALPHA);
+    });
+    report("codePointCount", n, [](CharArrayList &list) {
+        sink = list.codePointCount();
+    });
+    report("isValidUtf8", n, [](CharArrayList &list) {
+        sink = list.isValidUtf8();
+    });
+    report("hash", n, [](CharArrayList &list) {
+        // changing a char throws away the cached hash
+        list.replaceAt(list[0], 0);
+        sink = list.hash();
+    });
+    report("histogram", n, [](CharArrayList &list) {
+        sink = list.histogram()['e'];
+    });
+    CharArrayList pattern('#');
+    pattern.pushAtBack('!');
+    report("findSubsequence", n, [&pattern](CharArrayList &list) {
+        sink = list.findSubsequence(pattern);
+    });
+    report("operator==", n, [](CharArrayList &list) {
+        static CharArrayList other;
+        if (other.size() != list.size()) {
+            other = list;
+        }
+        sink = list == other;
+    });
+
+    // in place maps
+    report("toUpper", n, [](CharArrayList &list) { list.toUpper(); });
+    report("toLower", n, [](CharArrayList &list) { list.toLower(); });
+
+    // copies
+    report("copy assignment", n, [](CharArrayList &list) {
+        static CharArrayList copy;
+        copy.setAligned(list.isAligned());
+        copy = list;
+        sink = copy.size();
+    });
+    report("join", n, [](CharArrayList &list) {
+        CharArrayList joined = CharArrayList::join({ list.slice(0, 1),
+                                                     list.slice(1,
+                                                                list.size())
+                                                   });
+        sink = joined.size();
+    });
+    report("concatenate", n, [](CharArrayList &list) {
+        CharArrayList grown;
+        grown.setAligned(list.isAligned());
+        grown.concatenate(&list);
+        sink = grown.size();
+    });
+    return 0;
+}
@@ -0,0 +1,600 @@
+/*
+ *  complexity_tests.cpp
+ *  Name: Leo Kim
+ *  Date: 10/19/2026
+ *
+ *  Purpose: Allocation and complexity regression tests for CharArrayList.
+ *           Global operator new and delete are replaced so the tests can
+ *           count every heap allocation an operation makes, and each
+ *           operation is timed over sizes 2^10 and up so the exponent of
+ *           its running time can be fitted (the slope of log time against
+ *           log n) and compared with what it should be. Built as its own
+ *           program, complexity_test, since replacing operator new would
+ *           affect every other test.
+ *
+ *           Usage: ./complexity_test [largest log2 size, default 20]
+ *           Exits with the number of failed checks.
+ *
+ */
+
+#include "CharArrayList.h"
+#include "CharArrayAllocator.h"
+#include "CharArrayListColumn.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+// every call to a replaced operator new or new[]
+static std::atomic<long> allocations(0);
+
+void *operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    void *p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void *operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    std::size_t align = static_cast<std::size_t>(alignment);
+    void *p = std::aligned_alloc(align, (size + align - 1) / align * align);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+    return operator new(size, alignment);
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void *p, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+static int failures = 0;
+
+/*
+ * name:      check
+ * purpose:   records and prints the result of one check
+ * arguments: whether it passed, and a description of it
+ * returns:   none
+ * effects:   counts a failure if it did not pass
+ */
+static void check(bool passed, const std::string &description) {
+    std::printf("%s %s\n", passed ? "PASS" : "FAIL", description.c_str());
+    if (not passed) {
+        failures++;
+    }
+}
+
+/*
+ * name:      makeList
+ * purpose:   builds a list to run an operation on
+ * arguments: its size
+ * returns:   a list of n lowercase letters
+ * effects:   none
+ */
+static CharArrayList makeList(int n) {
+    std::string s(n, 'a');
+    for (int i = 0; i < n; i++) {
+        s[i] = 'a' + (i * 7) % 26;
+    }
+    return CharArrayList(&s[0], n);
+}
+
+/*
+ * name:      allocationsDuring
+ * purpose:   counts the heap allocations made by some code
+ * arguments: the code
+ * returns:   the number of calls to operator new and new[] while it ran
+ * effects:   runs the code
+ */
+static long allocationsDuring(const std::function<void()> &code) {
+    long before = allocations.load();
+    code();
+    return allocations.load() - before;
+}
+
+/*
+ * name:      allocationTests
+ * purpose:   checks how many allocations operations make
+ * arguments: none
+ * returns:   none
+ * effects:   prints a line per check
+ */
+static void allocationTests() {
+    const int n = 100000;
+    std::string s(n, 'x');
+    CharArrayList source = makeList(n);
+    CharArrayList other = makeList(n);
+    long count;
+
+    count = allocationsDuring([&]() { CharArrayList list(&s[0], n); });
+    check(count == 1, "array constructor allocates once (" +
+                          std::to_string(count) + ")");
+
+    count = allocationsDuring([&]() { CharArrayList copy(source); });
+    check(count == 1, "copy constructor allocates once (" +
+                          std::to_string(count) + ")");
+
+    count = allocationsDuring([&]() {
+        CharArrayList copy(std::move(other));
+        other = std::move(copy);
+    });
+    check(count == 0, "moves do not allocate (" + std::to_string(count) +
+                          ")");
+
+    count = allocationsDuring([&]() {
+        CharArrayList list;
+        for (int i = 0; i < n; i++) {
+            list.pushAtBack('a');
+        }
+    });
+    long growths = std::log2(n) + 2;
+    check(count <= growths, "n pushAtBacks allocate O(log n) times (" +
+                                std::to_string(count) + ")");
+
+    CharArrayList target = makeList(n);
+    count = allocationsDuring([&]() { target.concatenate(&source); });
+    check(count <= 1, "concatenate allocates at most once (" +
+                          std::to_string(count) + ")");
+    count = allocationsDuring([&]() { target.concatenate(&target); });
+    check(count <= 1, "concatenate with itself allocates at most once (" +
+                          std::to_string(count) + ")");
+
+    count = allocationsDuring([&]() { target.shrink(); });
+    check(count <= 1, "shrink allocates at most once (" +
+                          std::to_string(count) + ")");
+
+    count = allocationsDuring([&]() {
+        source.hash();
+        source.toUpper();
+        source.toLower();
+        source.isValidUtf8();
+        source.codePointCount();
+        source.histogram();
+        source.sort();
+        source.unique();
+        source.replaceAt('z', 3);
+        for (int i = 0; i < source.size(); i++) {
+            source.elementAt(i);
+        }
+        (void)(source == target);
+    });
+    check(count == 0, "read-only and in-place operations do not allocate (" +
+                          std::to_string(count) + ")");
+
+    std::string p = "zzzq";
+    CharArrayList pattern(&p[0], p.size());
+    count = allocationsDuring([&]() {
+        target.findSubsequence(pattern);
+        target.countSubsequence(pattern);
+    });
+    check(count == 0, "searching does not allocate (" +
+                          std::to_string(count) + ")");
+
+    std::vector<char> buffer(target.serializedSize());
+    count = allocationsDuring([&]() {
+        target.serialize(buffer.data(), buffer.size());
+    });
+    check(count == 0, "serializing into a buffer does not allocate (" +
+                          std::to_string(count) + ")");
+    count = allocationsDuring([&]() {
+        CharArrayList wrapped = CharArrayList::wrap(buffer.data(),
+                                                    buffer.size());
+    });
+    check(count == 0, "wrapping does not allocate (" +
+                          std::to_string(count) + ")");
+    count = allocationsDuring([&]() {
+        CharArrayList copy = CharArrayList::deserialize(buffer.data(),
+                                                        buffer.size());
+    });
+    check(count == 1, "deserializing allocates once (" +
+                          std::to_string(count) + ")");
+
+    std::vector<CharArrayList::Edit> edits;
+    for (int i = 0; i < 100; i++) {
+        edits.push_back({ CharArrayList::INSERT, 'q', i * 100 });
+    }
+    count = allocationsDuring([&]() {
+        target.applyEdits(edits.data(), edits.size());
+    });
+    check(count <= 3, "applyEdits allocates only the new array, a sorted "
+                      "copy of the edits and the sort's buffer (" +
+                      std::to_string(count) + ")");
+}
+
+// an operation to time: given n, it sets itself up, then returns the
+// seconds the part being measured took
+typedef std::function<double(int)> TimedOperation;
+
+/*
+ * name:      timeOf
+ * purpose:   times a piece of code
+ * arguments: the code
+ * returns:   the seconds it took
+ * effects:   runs the code
+ */
+static double timeOf(const std::function<void()> &code) {
+    auto start = std::chrono::steady_clock::now();
+    code();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+/*
+ * name:      measure
+ * purpose:   times an operation at one size, filtering out noise
+ * arguments: the operation and n
+ * returns:   the fastest of several runs: at least 3, and more (up to 100)
+ *            until 20ms have gone by, counting the operation's setup
+ * effects:   runs the operation
+ */
+static double measure(const TimedOperation &operation, int n) {
+    double best = 1e30;
+    auto start = std::chrono::steady_clock::now();
+    for (int run = 0; run < 100; run++) {
+        best = std::min(best, operation(n));
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        if (run >= 2 and elapsed.count() >= 0.02) {
+            break;
+        }
+    }
+    return std::max(best, 1e-9);
+}
+
+/*
+ * name:      checkExponent
+ * purpose:   fits the running time of an operation to c * n^k and checks k
+ * arguments: the operation's name, the exponent it should have, the
+ *            smallest and largest log2 sizes to time it at, and the
+ *            operation
+ * returns:   none
+ * effects:   fails if the fitted exponent is more than 0.5 above the
+ *            expected one. Cache effects can add a little to the slope
+ *            over this range of sizes, but not that much
+ */
+static void checkExponent(const std::string &name, double expected,
+                          int lowLog, int highLog,
+                          const TimedOperation &operation) {
+    // least squares fit of log(time) against log(n)
+    std::vector<double> xs, ys;
+    for (int k = lowLog; k <= highLog; k += 2) {
+        xs.push_back(k);
+        ys.push_back(std::log2(measure(operation, 1 << k)));
+    }
+    double meanX = 0, meanY = 0;
+    for (size_t i = 0; i < xs.size(); i++) {
+        meanX += xs[i] / xs.size();
+        meanY += ys[i] / ys.size();
+    }
+    double covariance = 0, variance = 0;
+    for (size_t i = 0; i < xs.size(); i++) {
+        covariance += (xs[i] - meanX) * (ys[i] - meanY);
+        variance += (xs[i] - meanX) * (xs[i] - meanX);
+    }
+    double slope = covariance / variance;
+
+    char line[160];
+    std::snprintf(line, sizeof(line),
+                  "%-28s n^%.2f (expected n^%.0f, sizes 2^%d..2^%d)",
+                  name.c_str(), slope, expected, lowLog, highLog);
+    check(slope <= expected + 0.5, line);
+}
+
+/*
+ * name:      scalingTests
+ * purpose:   checks the exponent of the running time of every public
+ *            operation
+ * arguments: the largest log2 size to time linear operations at
+ * returns:   none
+ * effects:   prints a line per operation
+ */
+static void scalingTests(int maxLog) {
+    const int low = 10;
+    // operations that are quadratic by nature (n pushes or pops at the
+    // front) only go up to 2^15
+    const int quadraticMax = std::min(maxLog, 15);
+
+    // building and copying
+    checkExponent("array constructor", 1, low, maxLog, [](int n) {
+        std::string s(n, 'a');
+        return timeOf([&]() { CharArrayList list(&s[0], n); });
+    });
+    checkExponent("copy constructor", 1, low, maxLog, [](int n) {
+        CharArrayList list = makeList(n);
+        return timeOf([&]() { CharArrayList copy(list); });
+    });
+    checkExponent("assignment operator", 1, low, maxLog, [](int n) {
+        CharArrayList list = makeList(n);
+        CharArrayList target;
+        return timeOf([&]() { target = list; });
+    });
+    checkExponent("n x pushAtBack", 1, low, maxLog, [](int n) {
+        CharArrayList list;
+        return timeOf([&]() {
+            for (int i = 0; i < n; i++) {
+                list.pushAtBack('a');
+            }
+        });
+    });
+    checkExponent("n x column appendRow / pushAtBack", 1, low, maxLog,
+                  [](int n) {
+        CharArrayListColumn column;
+        CharArrayList row = makeList(8);
+        return timeOf([&]() {
+            for (int i = 0; i < n; i++) {
+                column.appendRow(row);
+                column.pushAtBack(column.rows() - 1, 'a');
+            }
+        });
+    });
+    checkExponent("n x popFromBack", 1, low, maxLog, [](int n) {
+        CharArrayList list = makeList(n);
+        return timeOf([&]() {
+            for (int i = 0; i < n; i++) {
+                list.popFromBack();
+            }
+        });
+    });
+    checkExponent("n x pushAtFront", 2, low, quadraticMax, [](int n) {
+        CharArrayList list;
+        return timeOf([&]() {
+            for (int i = 0; i < n; i++) {
+                list.pushAtFront('a');
+            }
+        });
+    });
+    checkExponent("n x popFromFront", 2, low, quadraticMax, [](int n) {
+        CharArrayList list = makeList(n);
+        return timeOf([&]() {
+            for (int i = 0; i < n; i++) {
+                list.popFromFront();
+            }
+        });
+    });
+    checkExponent("n x insertAt middle", 2, low, quadraticMax, [](int n) {
+        CharArrayList list;
+        return timeOf([&]() {
+            for (int i = 0; i < n; i++) {
+                list.insertAt('a', list.size() / 2);
+            }
+        });
+    });
+    checkExponent("n x removeAt middle", 2, low, quadraticMax, [](int n) {
+        CharArrayList list = makeList(n);
+        return timeOf([&]() {
+            for (int i = 0; i < n; i++) {
+                list.removeAt(list.size() / 2);
+            }
+        });
+    });
+    // insertInOrder is left out: it ends the program (std::exit) as soon
+    // as it inserts anywhere but the back
+    checkExponent("concatenate", 1, low, maxLog, [](int n) {
+        CharArrayList list = makeList(n);
+        CharArrayList other = makeList(n);
+        return timeOf([&]() { list.concatenate(&other); });
+    });
+    checkExponent("shrink", 1, low, maxLog, [](int n) {
+        CharArrayList list = makeList(n);
+        list.pushAtBack('a');
+        return timeOf([&]() { list.shrink(); });
+    });
+    // freeing a large array costs the OS time per page
+    checkExponent("clear", 1, low, maxLog, [](int n) {
+        CharArrayList list = makeList(n);
+        return timeOf([&]() { list.clear(); });
+    });
+
+    // reading
+    checkExponent("n x elementAt", 1, low, maxLog, [](int n) {
+        CharArrayList list = makeList(n);
+        volatile char sink = 0;
+        return timeOf([&]() {
+            for (int i = 0; i < n; i++) {
+                sink = sink + list.elementAt(i);
+            }
+        });
+    });
+    checkExponent("toString", 1, low, maxLog, [](int n) {
+        CharArrayList list = makeList(n);
+        return timeOf([&]() { list.toString(); });
+    });
+    checkExponent("toReverseString", 1, low, maxLog, [](int n) {
+        CharArrayList list = makeList(n);
+        return timeOf([&]() { list.toReverseString(); });
+    });
+    checkExponent("operator== / <=>", 1, low, maxLog, [](int n) {
+        CharArrayList a = makeList(n);
+        CharArrayList b = makeList(n);
+        return timeOf([&]() {
+            (void)(a == b);
+            (void)(a <=> b);
+        });
+    });
+    checkExponent("hash", 1, low, maxLog, [](int n) {
+        CharArrayList list = makeList(n);
+        return timeOf([&]() { list.hash(); });
+    });
+    checkExponent("histogram", 1, low, maxLog, [](int n) {
+        CharArrayList list = makeList(n);
+        return timeOf([&]() { list.histogram(); });
+    });
+    checkExponent("countIf", 1, low, maxLog, [](int n) {
+        CharArrayList list = makeList(n);
+        return timeOf([&]() { list.countIf(CharArrayList::ALPHA); });
+    });
+    checkExponent("isValidUtf8 / codePointCount", 1, low, maxLog, [](int n) {
+        CharArrayList list = makeList(n);
+        return timeOf([&]() {
+            list.isValidUtf8();
+            list.codePointCount();
+        });
+    });
+    checkExponent("n x codePointOffset (index)", 1, low, maxLog, [](int n) {
+        CharArrayList list = makeList(n);
+        list.enableCodePointIndex(64);
+        return timeOf([&]() {
+            for (int i = 0; i < n; i += 97) {
+                list.codePointOffset(i);
+            }
+        });
+    });
+    checkExponent("n x pushAtBack + codePointOffset (index)", 1, low, maxLog,
+                  [](int n) {
+        CharArrayList list;
+        list.enableCodePointIndex(64);
+        return timeOf([&]() {
+            for (int i = 0; i < n; i++) {
+                list.pushAtBack('a' + i % 26);
+                list.codePointOffset(i);
+            }
+        });
+    });
+
+    // searching
+    checkExponent("findSubsequence", 1, low, maxLog, [](int n) {
+        CharArrayList list = makeList(n);
+        std::string p = "abcdefghij";
+        CharArrayList pattern(&p[0], p.size());
+        return timeOf([&]() { list.findSubsequence(pattern); });
+    });
+    checkExponent("countSubsequence", 1, low, maxLog, [](int n) {
+        CharArrayList list = makeList(n);
+        std::string p = "ahov";
+        CharArrayList pattern(&p[0], p.size());
+        return timeOf([&]() { list.countSubsequence(pattern); });
+    });
+    checkExponent("replaceAll", 1, low, maxLog, [](int n) {
+        CharArrayList list = makeList(n);
+        std::string p = "ah", r = "xyz";
+        CharArrayList pattern(&p[0], p.size());
+        CharArrayList replacement(&r[0], r.size());
+        return timeOf([&]() { list.replaceAll(pattern, replacement); });
+    });
+
+    // rewriting
+    checkExponent("applyEdits (n / 16 edits)", 1, low, maxLog, [](int n) {
+        CharArrayList list = makeList(n);
+        std::vector<CharArrayList::Edit> edits;
+        for (int i = 0; i < n; i += 16) {
+            edits.push_back({ CharArrayList::REPLACE, 'q', i });
+            edits.push_back({ CharArrayList::INSERT, 'r', i });
+        }
+        return timeOf([&]() {
+            list.applyEdits(edits.data(), edits.size());
+        });
+    });
+    checkExponent("toUpper / translate", 1, low, maxLog, [](int n) {
+        CharArrayList list = makeList(n);
+        uint8_t table[256];
+        for (int c = 0; c < 256; c++) {
+            table[c] = 255 - c;
+        }
+        return timeOf([&]() {
+            list.toUpper();
+            list.translate(table);
+        });
+    });
+    checkExponent("sort / unique / dedupe", 1, low, maxLog, [](int n) {
+        CharArrayList list = makeList(n);
+        CharArrayList copy = makeList(n);
+        return timeOf([&]() {
+            list.sort();
+            list.dedupeAdjacent();
+            copy.unique();
+        });
+    });
+
+    // splitting and joining
+    checkExponent("split / join / slice", 1, low, maxLog, [](int n) {
+        CharArrayList list = makeList(n);
+        return timeOf([&]() {
+            std::vector<CharArrayListView> pieces = list.split('a');
+            CharArrayList joined = CharArrayList::join(pieces, 'a');
+            joined.slice(0, joined.size() / 2).toString();
+        });
+    });
+
+    // the binary format
+    checkExponent("serialize / deserialize", 1, low, maxLog, [](int n) {
+        CharArrayList list = makeList(n);
+        std::vector<char> buffer(list.serializedSize());
+        return timeOf([&]() {
+            list.serialize(buffer.data(), buffer.size());
+            CharArrayList::deserialize(buffer.data(), buffer.size());
+        });
+    });
+
+    // comparing versions
+    checkExponent("diff (few changes)", 1, low, maxLog, [](int n) {
+        CharArrayList a = makeList(n);
+        CharArrayList b = makeList(n);
+        b.replaceAt('#', n / 3);
+        b.insertAt('#', n / 2);
+        return timeOf([&]() { CharArrayList::diff(a, b); });
+    });
+    checkExponent("editDistance (short side)", 1, low, maxLog, [](int n) {
+        CharArrayList a = makeList(n);
+        std::string s = "the short side";
+        CharArrayList b(&s[0], s.size());
+        return timeOf([&]() { CharArrayList::editDistance(a, b); });
+    });
+}
+
+int main(int argc, char *argv[]) {
+    int maxLog = argc > 1 ? std::atoi(argv[1]) : 20;
+    if (maxLog < 12 or maxLog > 24) {
+        std::fprintf(stderr, "largest log2 size must be in [12..24]\n");
+        return 1;
+    }
+
+    allocationTests();
+    scalingTests(maxLog);
+    std::printf("%d check%s failed\n", failures, failures == 1 ? "" : "s");
+    return failures;
+}
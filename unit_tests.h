@@ -11,7 +11,20 @@
  */
 
 #include "CharArrayList.h"
+#include "CharArrayAllocator.h"
+#include "CharArrayListWriter.h"
+#include "CharArrayListConcat.h"
+#include "CharArrayListInterner.h"
+#include "CharArrayListColumn.h"
+#include "CharArrayListShared.h"
+#include "CharArrayListStream.h"
+#include "CharPatternMatcher.h"
+#include "ArrayList.h"
 #include <cassert>
+#include <cstring>
+#include <thread>
+#include <atomic>
+#include <unistd.h>
 
 /********************************************************************\
 *                       CHAR ARRAY LIST TESTS                        *
@@ -778,3 +791,2017 @@ void clear_Test2() {
 }
 
 
+
+// TEST GROUP applyEdits
+
+void applyEdits_Test1() {
+    char test_arr[5] = { 'a', 'b', 'c', 'd', 'e'};
+    CharArrayList list(test_arr, 5);
+    CharArrayList::Edit edits[4] = {
+        { CharArrayList::REPLACE, 'z', 4 },
+        { CharArrayList::INSERT, 'x', 0 },
+        { CharArrayList::REMOVE, 0, 2 },
+        { CharArrayList::INSERT, 'y', 5 },
+    };
+    list.applyEdits(edits, 4);
+    assert(list.toString() == "[CharArrayList of size 6 <<xabdzy>>]");
+}
+
+void applyEdits_Test2() {
+    char test_arr[3] = { 'a', 'b', 'c'};
+    CharArrayList list(test_arr, 3);
+    CharArrayList::Edit edits[5] = {
+        { CharArrayList::INSERT, '1', 1 },
+        { CharArrayList::REMOVE, 0, 1 },
+        { CharArrayList::REPLACE, 'q', 1 },
+        { CharArrayList::INSERT, '2', 1 },
+        { CharArrayList::REMOVE, 0, 1 },
+    };
+    list.applyEdits(edits, 5);
+    assert(list.toString() == "[CharArrayList of size 4 <<a12c>>]");
+}
+
+void applyEdits_Test3() {
+    CharArrayList list;
+    CharArrayList::Edit edits[2] = {
+        { CharArrayList::INSERT, 'h', 0 },
+        { CharArrayList::INSERT, 'i', 0 },
+    };
+    list.applyEdits(edits, 2);
+    list.applyEdits(edits, 0);
+    assert(list.toString() == "[CharArrayList of size 2 <<hi>>]");
+}
+
+void applyEdits_Test4() {
+    char test_arr[3] = { 'a', 'b', 'c'};
+    CharArrayList list(test_arr, 3);
+    CharArrayList::Edit edits[2] = {
+        { CharArrayList::INSERT, 'x', 0 },
+        { CharArrayList::REMOVE, 0, 3 },
+    };
+    bool range_error_thrown = false;
+    std::string error_message = "";
+    try {
+        list.applyEdits(edits, 2);
+    }
+    catch (const std::range_error &e) {
+        range_error_thrown = true;
+        error_message = e.what();
+    }
+    assert(range_error_thrown);
+    assert(error_message == "index (3) not in range [0..3)");
+    assert(list.toString() == "[CharArrayList of size 3 <<abc>>]");
+}
+
+void applyEdits_Test5() {
+    char test_arr[3] = { 'a', 'b', 'c'};
+    CharArrayList list(test_arr, 3);
+    CharArrayList::Edit edits[1] = {
+        { CharArrayList::INSERT, 'x', 0 },
+    };
+    bool range_error_thrown = false;
+    std::string error_message = "";
+    try {
+        list.applyEdits(edits, -1);
+    }
+    catch (const std::range_error &e) {
+        range_error_thrown = true;
+        error_message = e.what();
+    }
+    assert(range_error_thrown);
+    assert(error_message == "number of edits (-1) must not be negative");
+    assert(list.toString() == "[CharArrayList of size 3 <<abc>>]");
+}
+
+// TEST GROUP findSubsequence
+
+void findSubsequence_Test1() {
+    char test_arr[8] = { 'b', 'a', 'n', 'a', 'n', 'a', 's', 's' };
+    char pattern_arr[3] = { 'a', 'n', 'a' };
+    CharArrayList list(test_arr, 8);
+    CharArrayList pattern(pattern_arr, 3);
+    assert(list.findSubsequence(pattern) == 1);
+    assert(list.findSubsequence(pattern, 2) == 3);
+    assert(list.findSubsequence(pattern, 4) == -1);
+}
+
+void findSubsequence_Test2() {
+    CharArrayList list;
+    CharArrayList empty;
+    CharArrayList pattern('a');
+    assert(list.findSubsequence(pattern) == -1);
+    assert(list.findSubsequence(empty) == 0);
+}
+
+void findSubsequence_Test3() {
+    // long enough for the Horspool path
+    CharArrayList list;
+    CharArrayList pattern;
+    for (int i = 0; i < 100; i++) {
+        list.pushAtBack('a' + i % 7);
+    }
+    for (int i = 50; i < 70; i++) {
+        pattern.pushAtBack('a' + i % 7);
+    }
+    assert(list.findSubsequence(pattern) == 1);
+    assert(list.findSubsequence(pattern, 2) == 8);
+    pattern.pushAtBack('z');
+    assert(list.findSubsequence(pattern) == -1);
+}
+
+void findSubsequence_Test4() {
+    CharArrayList list('a');
+    CharArrayList pattern('a');
+    bool range_error_thrown = false;
+    std::string error_message = "";
+    try {
+        list.findSubsequence(pattern, 2);
+    }
+    catch (const std::range_error &e) {
+        range_error_thrown = true;
+        error_message = e.what();
+    }
+    assert(range_error_thrown);
+    assert(error_message == "index (2) not in range [0..1]");
+}
+
+// TEST GROUP countSubsequence
+
+void countSubsequence_Test1() {
+    char test_arr[8] = { 'b', 'a', 'n', 'a', 'n', 'a', 's', 's' };
+    char pattern_arr[3] = { 'a', 'n', 'a' };
+    CharArrayList list(test_arr, 8);
+    CharArrayList pattern(pattern_arr, 3);
+    CharArrayList empty;
+    assert(list.countSubsequence(pattern) == 1);
+    assert(list.countSubsequence(CharArrayList('s')) == 2);
+    assert(list.countSubsequence(empty) == 0);
+}
+
+// TEST GROUP replaceAll
+
+void replaceAll_Test1() {
+    char test_arr[8] = { 'b', 'a', 'n', 'a', 'n', 'a', 's', 's' };
+    char pattern_arr[2] = { 'a', 'n' };
+    CharArrayList list(test_arr, 8);
+    CharArrayList pattern(pattern_arr, 2);
+    CharArrayList replacement('o');
+    assert(list.replaceAll(pattern, replacement) == 2);
+    assert(list.toString() == "[CharArrayList of size 6 <<booass>>]");
+}
+
+void replaceAll_Test2() {
+    char test_arr[3] = { 'a', 'b', 'a' };
+    CharArrayList list(test_arr, 3);
+    CharArrayList empty;
+    assert(list.replaceAll(CharArrayList('a'), empty) == 2);
+    assert(list.toString() == "[CharArrayList of size 1 <<b>>]");
+    assert(list.replaceAll(CharArrayList('z'), empty) == 0);
+    assert(list.replaceAll(list, list) == 1);
+    assert(list.toString() == "[CharArrayList of size 1 <<b>>]");
+}
+
+void replaceAll_Test3() {
+    char test_arr[3] = { 'x', 'y', 'x' };
+    CharArrayList list(test_arr, 3);
+    CharArrayList replacement(list);
+    assert(list.replaceAll(CharArrayList('x'), replacement) == 2);
+    assert(list.toString() == "[CharArrayList of size 7 <<xyxyxyx>>]");
+}
+
+// TEST GROUP CharPatternMatcher
+
+void patternMatcher_Test1() {
+    char he[2] = { 'h', 'e' };
+    char she[3] = { 's', 'h', 'e' };
+    char hers[4] = { 'h', 'e', 'r', 's' };
+    char text[8] = { 'u', 's', 'h', 'e', 'r', 's', 'h', 'e' };
+    CharPatternMatcher matcher;
+    assert(matcher.addPattern(CharArrayList(he, 2)) == 0);
+    assert(matcher.addPattern(CharArrayList(she, 3)) == 1);
+    assert(matcher.addPattern(CharArrayList(hers, 4)) == 2);
+    assert(matcher.patternCount() == 3);
+
+    std::string found = "";
+    int count = matcher.scan(CharArrayList(text, 8),
+        [&found](int id, int position) {
+            found += std::to_string(id) + "@" + std::to_string(position) + " ";
+        });
+    assert(count == 5);
+    assert(found == "1@1 0@2 2@2 1@5 0@6 ");
+}
+
+void patternMatcher_Test2() {
+    // a match split across two chunks is still reported
+    char abc[3] = { 'a', 'b', 'c' };
+    char chunk1[3] = { 'x', 'a', 'b' };
+    char chunk2[2] = { 'c', 'a' };
+    CharPatternMatcher matcher;
+    matcher.addPattern(CharArrayList(abc, 3));
+    matcher.addPattern(CharArrayList('a'));
+    matcher.addPattern(CharArrayList('a'));
+
+    std::string found = "";
+    CharPatternMatcher::MatchCallback record =
+        [&found](int id, int position) {
+            found += std::to_string(id) + "@" + std::to_string(position) + " ";
+        };
+    matcher.reset();
+    assert(matcher.feed(CharArrayList(chunk1, 3), record) == 2);
+    assert(matcher.feed(CharArrayList(chunk2, 2), record) == 3);
+    assert(found == "1@1 2@1 0@1 1@4 2@4 ");
+}
+
+void patternMatcher_Test3() {
+    CharPatternMatcher matcher;
+    CharArrayList empty;
+    bool runtime_error_thrown = false;
+    try {
+        matcher.addPattern(empty);
+    }
+    catch (const std::runtime_error &e) {
+        runtime_error_thrown = true;
+    }
+    assert(runtime_error_thrown);
+    assert(matcher.scan(CharArrayList('a'), [](int, int) {}) == 0);
+}
+
+// TEST GROUP toUpper / toLower
+
+void toUpper_Test1() {
+    char test_arr[8] = { 'b', 'A', 'n', '9', 'z', '{', '@', ' ' };
+    CharArrayList list(test_arr, 8);
+    list.toUpper();
+    assert(list.toString() == "[CharArrayList of size 8 <<BAN9Z{@ >>]");
+    list.toLower();
+    assert(list.toString() == "[CharArrayList of size 8 <<ban9z{@ >>]");
+}
+
+void toUpper_Test2() {
+    CharArrayList list;
+    list.toUpper();
+    list.toLower();
+    assert(list.size() == 0);
+}
+
+// TEST GROUP translate
+
+void translate_Test1() {
+    uint8_t rot13[256];
+    for (int c = 0; c < 256; c++) {
+        rot13[c] = c;
+    }
+    for (int c = 0; c < 26; c++) {
+        rot13['a' + c] = 'a' + (c + 13) % 26;
+    }
+    char test_arr[5] = { 'h', 'e', 'l', 'l', 'o' };
+    CharArrayList list(test_arr, 5);
+    list.translate(rot13);
+    assert(list.toString() == "[CharArrayList of size 5 <<uryyb>>]");
+    list.translate(rot13);
+    assert(list.toString() == "[CharArrayList of size 5 <<hello>>]");
+}
+
+// TEST GROUP countIf
+
+void countIf_Test1() {
+    char test_arr[10] = { 'a', '1', ' ', 'Z', '\t', '9', '\n', '_', '0', 'q' };
+    CharArrayList list(test_arr, 10);
+    assert(list.countIf(CharArrayList::DIGIT) == 3);
+    assert(list.countIf(CharArrayList::WHITESPACE) == 3);
+    assert(list.countIf(CharArrayList::ALPHA) == 3);
+    CharArrayList empty;
+    assert(empty.countIf(CharArrayList::ALPHA) == 0);
+}
+
+// TEST GROUP UTF-8
+
+void isValidUtf8_Test1() {
+    // "hé€\U0001F600!" followed by plain ASCII
+    std::string s = "h\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80!abcdefgh";
+    CharArrayList list(&s[0], s.size());
+    assert(list.isValidUtf8());
+    assert(list.codePointCount() == 13);
+    CharArrayList empty;
+    assert(empty.isValidUtf8());
+}
+
+void isValidUtf8_Test2() {
+    std::string bad[6] = { "\xC0\xAF", "\xE0\x80\xAF", "\xED\xA0\x80",
+                           "\xF4\x90\x80\x80", "\xE2\x82", "abc\x80" };
+    for (int i = 0; i < 6; i++) {
+        CharArrayList list(&bad[i][0], bad[i].size());
+        assert(not list.isValidUtf8());
+    }
+}
+
+void codePointOffset_Test1() {
+    std::string s = "a\xC3\xA9" "b\xE2\x82\xAC" "c";
+    CharArrayList list(&s[0], s.size());
+    assert(list.codePointOffset(0) == 0);
+    assert(list.codePointOffset(1) == 1);
+    assert(list.codePointOffset(2) == 3);
+    assert(list.codePointOffset(3) == 4);
+    assert(list.codePointOffset(4) == 7);
+    assert(list.codePointOffset(5) == 8);
+    assert(list.codePointRange(1, 4).toString() ==
+           "[CharArrayList of size 6 <<\xC3\xA9" "b\xE2\x82\xAC>>]");
+
+    bool range_error_thrown = false;
+    try {
+        list.codePointOffset(6);
+    }
+    catch (const std::range_error &e) {
+        range_error_thrown = true;
+        assert(std::string(e.what()) == "index (6) not in range [0..5]");
+    }
+    assert(range_error_thrown);
+}
+
+void codePointIndex_Test1() {
+    // the index gives the same answers as a plain scan while the list is
+    // changed around it
+    CharArrayList list;
+    CharArrayList plain;
+    list.enableCodePointIndex(3);
+    for (int i = 0; i < 40; i++) {
+        list.pushAtBack(i % 2 == 0 ? 'x' : '\xC3');
+        plain.pushAtBack(i % 2 == 0 ? 'x' : '\xC3');
+        if (i % 2 == 1) {
+            list.pushAtBack('\xA9');
+            plain.pushAtBack('\xA9');
+        }
+    }
+    assert(list.codePointOffset(39) == plain.codePointOffset(39));
+    list.insertAt('\xA9', 10);
+    plain.insertAt('\xA9', 10);
+    list.removeAt(31);
+    plain.removeAt(31);
+    list.pushAtFront('\xE2');
+    plain.pushAtFront('\xE2');
+    for (int n = 0; n <= plain.codePointCount(); n++) {
+        assert(list.codePointOffset(n) == plain.codePointOffset(n));
+    }
+    CharArrayList copy(list);
+    list.disableCodePointIndex();
+    assert(copy.codePointRange(5, 20).toString() ==
+           plain.codePointRange(5, 20).toString());
+}
+
+void codePointIndex_Test2() {
+    // every kind of change keeps the index in step with a plain scan,
+    // including chars that turn into, or stop being, code point starts
+    const char pieces[5] = { 'x', '\xC3', '\xA9', '\xE2', '\x82' };
+    CharArrayList list;
+    CharArrayList plain;
+    list.enableCodePointIndex(2);
+    unsigned int seed = 7;
+    for (int step = 0; step < 600; step++) {
+        seed = seed * 1103515245 + 12345;
+        char c = pieces[(seed >> 16) % 5];
+        int where = list.isEmpty() ? 0 : (seed >> 8) % list.size();
+        switch ((seed >> 20) % 8) {
+        case 0:
+        case 1:
+            list.pushAtBack(c);
+            plain.pushAtBack(c);
+            break;
+        case 2:
+            list.insertAt(c, where);
+            plain.insertAt(c, where);
+            break;
+        case 3:
+            list.pushAtFront(c);
+            plain.pushAtFront(c);
+            break;
+        case 4:
+            if (not list.isEmpty()) {
+                list.removeAt(where);
+                plain.removeAt(where);
+            }
+            break;
+        case 5:
+            if (not list.isEmpty()) {
+                list.replaceAt(c, where);
+                plain.replaceAt(c, where);
+            }
+            break;
+        case 6:
+            if (not list.isEmpty()) {
+                list.popFromFront();
+                plain.popFromFront();
+                list.tryPopFromBack();
+                plain.tryPopFromBack();
+            }
+            break;
+        default:
+            if (list.size() < 100) {
+                list.concatenate(&plain);
+                plain.concatenate(&plain);
+            }
+            break;
+        }
+        for (int n = 0; n <= plain.codePointCount(); n++) {
+            assert(list.codePointOffset(n) == plain.codePointOffset(n));
+        }
+    }
+
+    // and so do the functions that rewrite many chars at once
+    list.dedupeAdjacent();
+    plain.dedupeAdjacent();
+    list.sort();
+    plain.sort();
+    for (int n = 0; n <= plain.codePointCount(); n++) {
+        assert(list.codePointOffset(n) == plain.codePointOffset(n));
+    }
+    list.clear();
+    assert(list.codePointOffset(0) == 0);
+}
+
+// TEST GROUP comparison operators
+
+void equality_Test1() {
+    char test_arr[3] = { 'a', 'b', 'c' };
+    CharArrayList list1(test_arr, 3);
+    CharArrayList list2(test_arr, 3);
+    CharArrayList list3(test_arr, 2);
+    CharArrayList empty1;
+    CharArrayList empty2;
+    assert(list1 == list2);
+    assert(list1 != list3);
+    assert(empty1 == empty2);
+    list2.replaceAt('z', 2);
+    assert(list1 != list2);
+}
+
+void equality_Test2() {
+    // a stale hash must not make changed lists compare unequal
+    char test_arr[3] = { 'a', 'b', 'c' };
+    CharArrayList list1(test_arr, 3);
+    CharArrayList list2(test_arr, 3);
+    list2.replaceAt('z', 2);
+    list1.hash();
+    list2.hash();
+    list2.replaceAt('c', 2);
+    assert(list1 == list2);
+}
+
+void ordering_Test1() {
+    char test_arr[3] = { 'a', 'b', 'c' };
+    CharArrayList abc(test_arr, 3);
+    CharArrayList ab(test_arr, 2);
+    CharArrayList b('b');
+    CharArrayList high('\xE9');
+    CharArrayList empty;
+    assert(ab < abc);
+    assert(abc < b);
+    assert(empty < ab);
+    assert(b < high);
+    assert((abc <=> CharArrayList(abc)) == 0);
+    assert(abc >= ab);
+}
+
+// TEST GROUP hash
+
+void hash_Test1() {
+    // known XXH64 values
+    CharArrayList empty;
+    assert(empty.hash() == 0xEF46DB3751D8E999ULL);
+    CharArrayList a('a');
+    assert(a.hash() == 0xD24EC4F1A98C6E5BULL);
+    std::string s = "Nobody inspects the spammish repetition";
+    CharArrayList sentence(&s[0], s.size());
+    assert(sentence.hash() == 0xFBCEA83C8A378BF1ULL);
+}
+
+void hash_Test2() {
+    CharArrayList list1;
+    CharArrayList list2;
+    for (int i = 0; i < 100; i++) {
+        list1.pushAtBack('a' + i % 26);
+        list2.pushAtFront('a' + (99 - i) % 26);
+    }
+    assert(list1.hash() == list2.hash());
+    list1.popFromBack();
+    assert(list1.hash() != list2.hash());
+    list1.pushAtBack('a' + 99 % 26);
+    assert(list1.hash() == list2.hash());
+    assert(std::hash<CharArrayList>()(list1) == list1.hash());
+}
+
+void hash_Test3() {
+    // several threads hashing the same list for the first time agree, and
+    // agree with a fresh copy
+    std::string s(100000, 'q');
+    const CharArrayList list(&s[0], s.size());
+    uint64_t results[4];
+    std::vector<std::thread> hashers;
+    for (int t = 0; t < 4; t++) {
+        hashers.emplace_back([&list, &results, t]() {
+            results[t] = std::hash<CharArrayList>()(list);
+        });
+    }
+    for (std::thread &hasher : hashers) {
+        hasher.join();
+    }
+    CharArrayList copy(list);
+    for (int t = 0; t < 4; t++) {
+        assert(results[t] == copy.hash());
+    }
+    assert(list == copy);
+}
+
+// TEST GROUP auto-trim
+
+void autoTrim_Test1() {
+    // popping most of a large list gives memory back, and the contents
+    // survive the trims
+    CharArrayList list;
+    list.setAutoTrim(0.25);
+    for (int i = 0; i < 1000; i++) {
+        list.pushAtBack('a' + i % 26);
+    }
+    for (int i = 0; i < 990; i++) {
+        list.popFromBack();
+    }
+    assert(list.size() == 10);
+    assert(list.toString() == "[CharArrayList of size 10 <<abcdefghij>>]");
+    // a list trimmed this far has nothing left for trimAll to release
+    // beyond the headroom of its last trim
+    assert(CharArrayList::trimAll() < 64);
+    assert(CharArrayList::trimAll() == 0);
+}
+
+void autoTrim_Test2() {
+    CharArrayList list;
+    for (int i = 0; i < 100; i++) {
+        list.pushAtBack('x');
+    }
+    for (int i = 0; i < 95; i++) {
+        list.removeAt(0);
+    }
+    // not opted in, so trimAll leaves it alone
+    assert(CharArrayList::trimAll() == 0);
+    list.setAutoTrim(0.1);
+    assert(CharArrayList::trimAll() == 121);
+    list.setAutoTrim(0);
+    assert(list.toString() == "[CharArrayList of size 5 <<xxxxx>>]");
+}
+
+void autoTrim_Test3() {
+    CharArrayList list;
+    bool range_error_thrown = false;
+    try {
+        list.setAutoTrim(0.5);
+    }
+    catch (const std::range_error &e) {
+        range_error_thrown = true;
+    }
+    assert(range_error_thrown);
+}
+
+void Shrink_Test5() {
+    CharArrayList list1('a');
+    list1.popFromFront();
+    list1.shrink();
+    assert(list1.size() == 0);
+    list1.pushAtBack('b');
+    assert(list1.toString() == "[CharArrayList of size 1 <<b>>]");
+}
+
+// TEST GROUP CharArrayAllocator
+
+void allocator_Test1() {
+    // without pooling, capacity 0 gives no array and the rest is the heap
+    assert(CharArrayAllocator::allocate(0) == nullptr);
+    CharArrayAllocator::release(nullptr, 0);
+    char *array = CharArrayAllocator::allocate(6);
+    CharArrayAllocator::release(array, 6);
+    assert(CharArrayAllocator::drainPool() == 0);
+}
+
+void allocator_Test2() {
+    // a released growth-size array is handed out again
+    CharArrayAllocator::setPooling(true);
+    char *array1 = CharArrayAllocator::allocate(30);
+    CharArrayAllocator::release(array1, 30);
+    char *array2 = CharArrayAllocator::allocate(30);
+    assert(array1 == array2);
+    CharArrayAllocator::release(array2, 30);
+
+    // other sizes are not pooled
+    char *array3 = CharArrayAllocator::allocate(31);
+    CharArrayAllocator::release(array3, 31);
+    assert(CharArrayAllocator::drainPool() == 30);
+    CharArrayAllocator::setPooling(false);
+}
+
+void allocator_Test3() {
+    // lists built and destroyed over and over keep working with pooling
+    CharArrayAllocator::setPooling(true);
+    for (int round = 0; round < 10; round++) {
+        CharArrayList list;
+        for (int i = 0; i < 100; i++) {
+            list.pushAtBack('a' + (i + round) % 26);
+        }
+        CharArrayList copy(list);
+        list.clear();
+        assert(copy.size() == 100);
+        assert(copy.elementAt(99) == 'a' + (99 + round) % 26);
+    }
+    assert(CharArrayAllocator::drainPool() > 0);
+    CharArrayAllocator::setPooling(false);
+}
+
+void allocator_Test4() {
+    // growing past the large array size moves to mapped memory and keeps
+    // every element, as does shrinking back below it
+    CharArrayAllocator::setHugePages(true);
+    CharArrayList list;
+    int n = CharArrayAllocator::LARGE_ARRAY_SIZE * 2;
+    for (int i = 0; i < n; i++) {
+        list.pushAtBack('a' + i % 26);
+    }
+    for (int i = 0; i < n; i += 4099) {
+        assert(list.elementAt(i) == 'a' + i % 26);
+    }
+    list.shrink();
+    assert(list.elementAt(n - 1) == 'a' + (n - 1) % 26);
+    for (int i = 0; i < n - 10; i++) {
+        list.popFromBack();
+    }
+    list.shrink();
+    assert(list.toString() == "[CharArrayList of size 10 <<abcdefghij>>]");
+    CharArrayAllocator::setHugePages(false);
+}
+
+// TEST GROUP move constructor / move assignment
+
+void Move_Test1() {
+    char test_arr[5] = { 'a', 'b', 'c', 'd', 'e'};
+    CharArrayList list1(test_arr, 5);
+    CharArrayList list2(std::move(list1));
+    assert(list1.size() == 0);
+    assert(list2.toString() == "[CharArrayList of size 5 <<abcde>>]");
+    CharArrayList list3('z');
+    list3 = std::move(list2);
+    assert(list2.toString() == "[CharArrayList of size 0 <<>>]");
+    assert(list3.toString() == "[CharArrayList of size 5 <<abcde>>]");
+    list2.pushAtBack('q');
+    assert(list2.toString() == "[CharArrayList of size 1 <<q>>]");
+}
+
+// TEST GROUP serialize
+
+void serialize_Test1() {
+    // round trip, including chars toString cannot represent unambiguously
+    char test_arr[6] = { 'a', '>', '>', ']', '\0', 'b' };
+    CharArrayList list(test_arr, 6);
+    char buffer[256];
+    assert(list.serializedSize() == 128);
+    assert(list.serialize(buffer, 256) == 128);
+    CharArrayList copy = CharArrayList::deserialize(buffer, 128);
+    assert(copy == list);
+    assert(not copy.isWrapped());
+
+    CharArrayList empty;
+    assert(empty.serialize(buffer, 256, false) == 64);
+    assert(CharArrayList::deserialize(buffer, 64).size() == 0);
+}
+
+void serialize_Test2() {
+    // a wrapped list reads from the buffer until it is changed
+    CharArrayList list;
+    for (int i = 0; i < 100; i++) {
+        list.pushAtBack('a' + i % 26);
+    }
+    char *buffer = new char[list.serializedSize()];
+    list.serialize(buffer, list.serializedSize());
+    CharArrayList wrapped = CharArrayList::wrap(buffer,
+                                                list.serializedSize());
+    assert(wrapped.isWrapped());
+    assert(wrapped == list);
+    assert(wrapped.hash() == list.hash());
+    CharArrayList moved(std::move(wrapped));
+    assert(moved.isWrapped());
+
+    moved.replaceAt('!', 0);
+    assert(not moved.isWrapped());
+    assert(buffer[CharArrayList::SERIAL_HEADER_SIZE] == 'a');
+    moved.pushAtBack('?');
+    assert(moved.size() == 101);
+    assert(moved.elementAt(0) == '!');
+    delete [] buffer;
+}
+
+void serialize_Test3() {
+    char test_arr[3] = { 'a', 'b', 'c' };
+    CharArrayList list(test_arr, 3);
+    char buffer[128];
+    list.serialize(buffer, 128);
+
+    std::string messages[4] = { "", "", "", "" };
+    char bad[4][128];
+    for (int i = 0; i < 4; i++) {
+        std::memcpy(bad[i], buffer, 128);
+    }
+    bad[0][0] = 'X';
+    bad[1][4] = 9;
+    bad[3][CharArrayList::SERIAL_HEADER_SIZE + 1] = 'B';
+    long sizes[4] = { 128, 128, 66, 128 };
+    for (int i = 0; i < 4; i++) {
+        try {
+            CharArrayList::deserialize(bad[i], sizes[i]);
+        }
+        catch (const std::runtime_error &e) {
+            messages[i] = e.what();
+        }
+    }
+    assert(messages[0] == "not a serialized ArrayList");
+    assert(messages[1] == "unsupported serialized ArrayList version");
+    assert(messages[2] == "serialized ArrayList is truncated");
+    assert(messages[3] == "serialized ArrayList is corrupt");
+    // skipping verification skips the checksum
+    assert(CharArrayList::wrap(bad[3], 128, false).elementAt(1) == 'B');
+
+    try {
+        list.serialize(buffer, 100);
+    }
+    catch (const std::runtime_error &e) {
+        messages[0] = e.what();
+    }
+    assert(messages[0] == "buffer too small to serialize ArrayList");
+}
+
+void serialize_Test4() {
+    // writing to a file descriptor gives the same bytes
+    char test_arr[3] = { 'x', 'y', 'z' };
+    CharArrayList list(test_arr, 3);
+    int fds[2];
+    assert(pipe(fds) == 0);
+    list.serialize(fds[1]);
+    close(fds[1]);
+    char buffer[256];
+    long total = 0;
+    long got;
+    while ((got = read(fds[0], buffer + total, 256 - total)) > 0) {
+        total += got;
+    }
+    close(fds[0]);
+    assert(total == 128);
+    assert(CharArrayList::deserialize(buffer, total) == list);
+}
+
+// TEST GROUP CharArrayListWriter
+
+void writer_Test1() {
+    // lists for one file descriptor arrive in submission order, from two
+    // threads and with a queue limit small enough to make submit wait
+    char path[] = "/tmp/CharArrayListWriterXXXXXX";
+    int fd = mkstemp(path);
+    assert(fd != -1);
+    {
+        CharArrayListWriter writer(2, 16);
+        std::future<void> last;
+        for (int i = 0; i < 50; i++) {
+            CharArrayList list;
+            for (int j = 0; j < 5; j++) {
+                list.pushAtBack('a' + i % 26);
+            }
+            last = writer.submit(fd, std::move(list));
+            assert(list.size() == 0);
+        }
+        CharArrayList snapshot('!');
+        std::future<void> done = writer.submit(fd, snapshot);
+        snapshot.replaceAt('?', 0);
+        done.get();
+        last.get();
+        writer.flush();
+        assert(writer.queuedBytes() == 0);
+    }
+
+    char contents[300];
+    long got = pread(fd, contents, 300, 0);
+    close(fd);
+    unlink(path);
+    assert(got == 251);
+    for (int i = 0; i < 250; i++) {
+        assert(contents[i] == 'a' + (i / 5) % 26);
+    }
+    assert(contents[250] == '!');
+}
+
+void writer_Test2() {
+    // a failed write is reported through the future
+    CharArrayListWriter writer;
+    std::future<void> done = writer.submit(-1, CharArrayList('x'));
+    bool runtime_error_thrown = false;
+    try {
+        done.get();
+    }
+    catch (const std::runtime_error &e) {
+        runtime_error_thrown = true;
+    }
+    assert(runtime_error_thrown);
+}
+
+// TEST GROUP split
+
+void split_Test1() {
+    std::string s = "ab,,c,";
+    CharArrayList list(&s[0], s.size());
+    std::vector<CharArrayListView> pieces = list.split(',');
+    assert(pieces.size() == 4);
+    assert(pieces.capacity() == 4);
+    assert(pieces[0].toString() == "[CharArrayList of size 2 <<ab>>]");
+    assert(pieces[1].isEmpty());
+    assert(pieces[2].elementAt(0) == 'c');
+    assert(pieces[3].size() == 0);
+
+    CharArrayList empty;
+    assert(empty.split(',').size() == 1);
+}
+
+void split_Test2() {
+    CharArrayListView view;
+    bool range_error_thrown = false;
+    std::string error_message = "";
+    try {
+        view.elementAt(0);
+    }
+    catch (const std::range_error &e) {
+        range_error_thrown = true;
+        error_message = e.what();
+    }
+    assert(range_error_thrown);
+    assert(error_message == "index (0) not in range [0..0)");
+}
+
+// TEST GROUP CharArrayListTokenizer
+
+void tokenizer_Test1() {
+    std::string s = "\none\n\ntwo\n";
+    CharArrayList list(&s[0], s.size());
+    CharArrayListTokenizer lines(list, '\n', true);
+    CharArrayListView line;
+    assert(lines.next(line));
+    assert(line.toString() == "[CharArrayList of size 3 <<one>>]");
+    assert(lines.next(line));
+    assert(line.toString() == "[CharArrayList of size 3 <<two>>]");
+    assert(not lines.next(line));
+    assert(not lines.next(line));
+
+    CharArrayListTokenizer all(list, '\n');
+    int count = 0;
+    while (all.next(line)) {
+        count++;
+    }
+    assert(count == 5);
+}
+
+// TEST GROUP join
+
+void join_Test1() {
+    std::string s = "a b  cd";
+    CharArrayList list(&s[0], s.size());
+    CharArrayList joined = CharArrayList::join(list.split(' '), '-');
+    assert(joined.toString() == "[CharArrayList of size 7 <<a-b--cd>>]");
+
+    std::vector<CharArrayListView> none;
+    assert(CharArrayList::join(none, '-').size() == 0);
+    std::vector<CharArrayListView> blanks(3);
+    assert(CharArrayList::join(blanks, '+').toString() ==
+           "[CharArrayList of size 2 <<++>>]");
+}
+
+void concatenate_Test7() {
+    // repeated self-concatenation doubles the list each time
+    CharArrayList list('a');
+    for (int i = 0; i < 10; i++) {
+        list.concatenate(&list);
+    }
+    assert(list.size() == 1024);
+    assert(list.countSubsequence(CharArrayList('a')) == 1024);
+}
+
+// TEST GROUP slice
+
+void slice_Test1() {
+    std::string s = "bananas";
+    CharArrayList list(&s[0], s.size());
+    CharArrayListView view = list.slice(1, 6);
+    assert(view.toString() == "[CharArrayList of size 5 <<anana>>]");
+    assert(view.first() == 'a');
+    assert(view.last() == 'a');
+    assert(view.elementAt(2) == 'a');
+    assert(view.slice(1, 3).toString() ==
+           "[CharArrayList of size 2 <<na>>]");
+    assert(view.findSubsequence(list.slice(3, 5)) == 0);
+    assert(view.findSubsequence(list.slice(3, 5), 1) == 2);
+    assert(view.findSubsequence(list.slice(0, 1)) == -1);
+    assert(list.slice(2, 2).isEmpty());
+    // replacing in place keeps the array, so the view stays valid
+    list.replaceAt('A', 1);
+    assert(view.first() == 'A');
+}
+
+void slice_Test2() {
+    std::string s = "abcabd";
+    CharArrayList list(&s[0], s.size());
+    assert(list.slice(0, 2) == list.slice(3, 5));
+    assert(list.slice(0, 3) != list.slice(3, 6));
+    assert(list.slice(0, 3) < list.slice(3, 6));
+    assert(list.slice(0, 2) < list.slice(0, 3));
+    assert((list.slice(0, 0) <=> CharArrayListView()) == 0);
+}
+
+void slice_Test3() {
+    CharArrayList list('a');
+    std::string messages[3] = { "", "", "" };
+    try {
+        list.slice(2, 2);
+    }
+    catch (const std::range_error &e) {
+        messages[0] = e.what();
+    }
+    try {
+        list.slice(1, 0);
+    }
+    catch (const std::range_error &e) {
+        messages[1] = e.what();
+    }
+    try {
+        list.slice(0, 0).first();
+    }
+    catch (const std::runtime_error &e) {
+        messages[2] = e.what();
+    }
+    assert(messages[0] == "index (2) not in range [0..1]");
+    assert(messages[1] == "index (0) not in range [1..1]");
+    assert(messages[2] == "cannot get first of empty ArrayList");
+}
+
+// TEST GROUP CharArrayListConcat
+
+void concat_Test1() {
+    std::string s1 = "hello";
+    std::string s2 = ", ";
+    std::string s3 = "world";
+    CharArrayList list1(&s1[0], s1.size());
+    CharArrayList list2(&s2[0], s2.size());
+    CharArrayList list3(&s3[0], s3.size());
+    CharArrayList empty;
+
+    CharArrayListConcat greeting;
+    greeting.append(list1);
+    greeting.append(list2);
+    greeting.append(empty);
+    greeting.append(list3.slice(0, 3));
+    assert(greeting.size() == 10);
+    assert(greeting.pieceCount() == 3);
+    assert(greeting.elementAt(7) == 'w');
+    assert(greeting.pieceCount() == 1);
+    greeting.append(list3.slice(3, 5));
+    greeting.append(greeting);
+    assert(greeting.toString() ==
+           "[CharArrayList of size 24 <<hello, worldhello, world>>]");
+
+    CharArrayList built = greeting.build();
+    assert(built.size() == 24);
+    assert(greeting.isEmpty());
+    assert(greeting.toString() == "[CharArrayList of size 0 <<>>]");
+}
+
+void concat_Test2() {
+    // writing out streams the pieces without joining them
+    std::string s = "abc";
+    CharArrayList list(&s[0], s.size());
+    CharArrayListConcat pieces;
+    for (int i = 0; i < 2000; i++) {
+        pieces.append(list);
+    }
+    char path[] = "/tmp/CharArrayListConcatXXXXXX";
+    int fd = mkstemp(path);
+    assert(fd != -1);
+    pieces.writeTo(fd);
+    assert(pieces.pieceCount() == 2000);
+
+    char contents[6001];
+    long got = pread(fd, contents, 6001, 0);
+    close(fd);
+    unlink(path);
+    assert(got == 6000);
+    assert(contents[0] == 'a' and contents[5999] == 'c');
+}
+
+// TEST GROUP histogram
+
+void histogram_Test1() {
+    std::string s = "bananas\xFF";
+    CharArrayList list(&s[0], s.size());
+    std::array<int, 256> counts = list.histogram();
+    assert(counts['a'] == 3);
+    assert(counts['n'] == 2);
+    assert(counts['b'] == 1);
+    assert(counts[0xFF] == 1);
+    assert(counts['z'] == 0);
+}
+
+void histogram_Test2() {
+    // the threaded count agrees with the single threaded one
+    CharArrayList list;
+    for (int i = 0; i < 300000; i++) {
+        list.pushAtBack(static_cast<char>(i * 7 % 251));
+    }
+    assert(list.histogram(4) == list.histogram(1));
+    int total = 0;
+    std::array<int, 256> counts = list.histogram(3);
+    for (int c = 0; c < 256; c++) {
+        total += counts[c];
+    }
+    assert(total == 300000);
+}
+
+// TEST GROUP sort
+
+void sort_Test1() {
+    std::string s = "bananas\xE9!";
+    CharArrayList list(&s[0], s.size());
+    list.sort();
+    assert(list.toString() == "[CharArrayList of size 9 <<!aaabnns\xE9>>]");
+    CharArrayList empty;
+    empty.sort();
+    assert(empty.size() == 0);
+}
+
+// TEST GROUP unique / dedupeAdjacent
+
+void unique_Test1() {
+    std::string s = "mississippi";
+    CharArrayList list(&s[0], s.size());
+    CharArrayList copy(list);
+    list.unique();
+    assert(list.toString() == "[CharArrayList of size 4 <<misp>>]");
+    copy.dedupeAdjacent();
+    assert(copy.toString() == "[CharArrayList of size 8 <<misisipi>>]");
+    CharArrayList empty;
+    empty.unique();
+    empty.dedupeAdjacent();
+    assert(empty.size() == 0);
+}
+
+// TEST GROUP operator[] / try functions
+
+void try_Test1() {
+    std::string s = "abc";
+    CharArrayList list(&s[0], s.size());
+    assert(list[0] == 'a');
+    assert(list[2] == 'c');
+    assert(list.tryElementAt(1) == 'b');
+    assert(not list.tryElementAt(3).has_value());
+    assert(not list.tryElementAt(-1).has_value());
+
+    assert(not list.tryReplaceAt('x', 3));
+    assert(list.tryReplaceAt('x', 1));
+    assert(not list.tryInsertAt('y', 4));
+    assert(list.tryInsertAt('y', 3));
+    assert(not list.tryRemoveAt(-1));
+    assert(list.tryRemoveAt(0));
+    assert(list.toString() == "[CharArrayList of size 3 <<xcy>>]");
+}
+
+void try_Test2() {
+    CharArrayList list;
+    assert(not list.tryPopFromBack());
+    assert(not list.tryPopFromFront());
+    list.pushAtBack('a');
+    list.pushAtBack('b');
+    assert(list.tryPopFromFront());
+    assert(list.tryPopFromBack());
+    assert(list.isEmpty());
+}
+
+void try_Test3() {
+    // the checked functions keep their messages
+    CharArrayList list('a');
+    std::string message;
+    try {
+        list.elementAt(5);
+    } catch (const std::range_error &e) {
+        message = e.what();
+    }
+    assert(message == "index (5) not in range [0..1)");
+    message = "";
+    try {
+        list.replaceAt('b', -2);
+    } catch (const std::range_error &e) {
+        message = e.what();
+    }
+    assert(message == "index (-2) not in range [0..1)");
+    list.clear();
+    message = "";
+    try {
+        list.first();
+    } catch (const std::runtime_error &e) {
+        message = e.what();
+    }
+    assert(message == "cannot get first of empty ArrayList");
+}
+
+// TEST GROUP CharArrayListInterner
+
+void interner_Test1() {
+    CharArrayListInterner interner;
+    std::string a = "apple", b = "pear";
+    CharArrayList apple(&a[0], a.size());
+    CharArrayList pear(&b[0], b.size());
+    CharArrayList apple2(apple);
+
+    CharArrayListInterner::Handle h1 = interner.intern(apple);
+    CharArrayListInterner::Handle h2 = interner.intern(pear);
+    CharArrayListInterner::Handle h3 = interner.intern(apple2);
+    assert(h1 == h3);
+    assert(h1 != h2);
+    assert(interner.count() == 2);
+    assert(interner.size(h2) == 4);
+    assert(interner.view(h1).toString() ==
+           "[CharArrayList of size 5 <<apple>>]");
+    assert(interner.contains(pear.slice(0, 4)));
+    assert(not interner.contains(pear.slice(0, 3)));
+
+    // the empty list is an entry like any other
+    CharArrayList empty;
+    CharArrayListInterner::Handle h4 = interner.intern(empty);
+    assert(interner.intern(empty) == h4);
+    assert(interner.size(h4) == 0);
+}
+
+void interner_Test2() {
+    // changes go to a materialized copy, never to the interned chars
+    CharArrayListInterner interner;
+    std::string a = "apple";
+    CharArrayList apple(&a[0], a.size());
+    CharArrayListInterner::Handle h = interner.intern(apple);
+    CharArrayList copy = interner.materialize(h);
+    copy.replaceAt('A', 0);
+    assert(interner.view(h).first() == 'a');
+    assert(interner.intern(copy) != h);
+
+    bool thrown = false;
+    try {
+        interner.view(7);
+    } catch (const std::range_error &e) {
+        thrown = true;
+        assert(std::string(e.what()) == "handle (7) not in range [0..2)");
+    }
+    assert(thrown);
+}
+
+void interner_Test3() {
+    // enough entries to grow the table and fill several arena blocks, with
+    // views handed out early still valid at the end
+    CharArrayListInterner interner;
+    CharArrayList big;
+    for (int i = 0; i < 40000; i++) {
+        big.pushAtBack('x');
+    }
+    CharArrayListInterner::Handle bigHandle = interner.intern(big);
+    CharArrayListView firstView;
+    for (int round = 0; round < 2; round++) {
+        for (int i = 0; i < 20000; i++) {
+            std::string s = "key" + std::to_string(i);
+            CharArrayList key(&s[0], s.size());
+            CharArrayListInterner::Handle h = interner.intern(key);
+            assert(h == static_cast<CharArrayListInterner::Handle>(i + 1));
+            if (i == 0 and round == 0) {
+                firstView = interner.view(h);
+            }
+        }
+    }
+    assert(interner.count() == 20001);
+    assert(firstView.toString() == "[CharArrayList of size 4 <<key0>>]");
+    assert(interner.view(bigHandle).size() == 40000);
+    assert(interner.view(bigHandle) == big.slice(0, big.size()));
+}
+
+// TEST GROUP CharArrayListColumn
+
+void column_Test1() {
+    CharArrayListColumn column;
+    assert(column.isEmpty());
+    std::string a = "cat", b = "dog";
+    CharArrayList cat(&a[0], a.size());
+    CharArrayList dog(&b[0], b.size());
+    CharArrayList empty;
+    column.appendRow(cat);
+    column.appendRow(empty);
+    column.appendRow(dog);
+    assert(column.rows() == 3);
+    assert(column.totalSize() == 6);
+    assert(column.rowSize(1) == 0);
+    assert(column.elementAt(2, 1) == 'o');
+    assert(column.toString(0) == "[CharArrayList of size 3 <<cat>>]");
+    assert(column.toString(1) == "[CharArrayList of size 0 <<>>]");
+
+    // growing a row in the middle moves the rows after it
+    column.pushAtBack(0, 's');
+    column.pushAtBack(1, '!');
+    column.pushAtBack(2, 's');
+    assert(column.toString(0) == "[CharArrayList of size 4 <<cats>>]");
+    assert(column.toString(1) == "[CharArrayList of size 1 <<!>>]");
+    assert(column.toString(2) == "[CharArrayList of size 4 <<dogs>>]");
+    dog.pushAtBack('s');
+    assert(column.materialize(2) == dog);
+
+    bool thrown = false;
+    try {
+        column.elementAt(3, 0);
+    } catch (const std::range_error &e) {
+        thrown = true;
+        assert(std::string(e.what()) == "row (3) not in range [0..3)");
+    }
+    assert(thrown);
+    thrown = false;
+    try {
+        column.elementAt(1, 1);
+    } catch (const std::range_error &e) {
+        thrown = true;
+        assert(std::string(e.what()) == "index (1) not in range [0..1)");
+    }
+    assert(thrown);
+}
+
+void column_Test2() {
+    // matches that run across a row boundary do not count
+    std::string s = "abxyz,xab,yab,ab,,zab";
+    CharArrayList list(&s[0], s.size());
+    CharArrayListColumn column;
+    column.appendRows(list.split(','));
+    assert(column.rows() == 6);
+    std::string p = "ab";
+    CharArrayList pattern(&p[0], p.size());
+    std::vector<int> rows = column.findRows(pattern.slice(0, 2));
+    assert((rows == std::vector<int>{ 0, 1, 2, 3, 5 }));
+    std::string q = "bx";
+    CharArrayList noMatch(&q[0], q.size());
+    assert((column.findRows(noMatch.slice(0, 2)) == std::vector<int>{ 0 }));
+    std::string r = "bz";
+    CharArrayList across(&r[0], r.size());
+    assert(column.findRows(across.slice(0, 2)).empty());
+    assert(column.findRows(CharArrayListView()).size() == 6);
+}
+
+void column_Test3() {
+    CharArrayListColumn column;
+    for (int i = 0; i < 1000; i++) {
+        std::string s = std::to_string(i);
+        CharArrayList row(&s[0], s.size());
+        column.appendRow(row);
+    }
+    CharArrayListColumn small = column.filter(
+        [](const CharArrayListView &row) { return row.size() == 1; });
+    assert(small.rows() == 10);
+    assert(small.toString(9) == "[CharArrayList of size 1 <<9>>]");
+
+    // rows of the column itself can be appended to it
+    column.appendRows({ column.view(999), column.view(5) });
+    assert(column.rows() == 1002);
+    assert(column.toString(1000) == "[CharArrayList of size 3 <<999>>]");
+    assert(column.toString(1001) == "[CharArrayList of size 1 <<5>>]");
+    column.clear();
+    assert(column.isEmpty());
+    assert(column.totalSize() == 0);
+}
+
+// TEST GROUP CharArrayListShared
+
+void shared_Test1() {
+    std::string s = "ab";
+    CharArrayList initial(&s[0], s.size());
+    CharArrayListShared shared(initial);
+    assert(shared.version() == 0);
+
+    // a reader keeps the snapshot it started with across publishes
+    CharArrayListShared::ReadGuard before = shared.read();
+    shared.draft().pushAtBack('c');
+    assert(before->size() == 2);
+    shared.publish();
+    assert(shared.version() == 1);
+    assert(before->toString() == "[CharArrayList of size 2 <<ab>>]");
+    assert(shared.read()->toString() == "[CharArrayList of size 3 <<abc>>]");
+
+    // the first snapshot is only freed after its reader lets go
+    assert(shared.retiredCount() == 1);
+    {
+        CharArrayListShared::ReadGuard done = std::move(before);
+    }
+    shared.draft().removeAt(0);
+    shared.publish();
+    assert(shared.retiredCount() == 0);
+    assert((*shared.read()).first() == 'b');
+}
+
+void shared_Test2() {
+    // readers on several threads only ever see whole snapshots: every
+    // published version is a run of 'x' as long as its version number
+    CharArrayListShared shared;
+    std::atomic<bool> done(false);
+    std::atomic<bool> bad(false);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; t++) {
+        readers.emplace_back([&]() {
+            while (not done.load()) {
+                CharArrayListShared::ReadGuard snapshot = shared.read();
+                int size = snapshot->size();
+                for (int i = 0; i < size; i++) {
+                    if ((*snapshot)[i] != 'x') {
+                        bad.store(true);
+                    }
+                }
+            }
+        });
+    }
+    for (int v = 0; v < 2000; v++) {
+        shared.draft().pushAtBack('x');
+        shared.publish();
+    }
+    done.store(true);
+    for (std::thread &reader : readers) {
+        reader.join();
+    }
+    assert(not bad.load());
+    assert(shared.read()->size() == 2000);
+    shared.publish();
+    assert(shared.retiredCount() == 0);
+}
+
+// TEST GROUP CharArrayAllocator accounting
+
+void accounting_Test1() {
+    // arrays are counted while lists hold them, against the current tag
+    CharArrayAllocator::Stats before = CharArrayAllocator::stats();
+    int parser = CharArrayAllocator::registerTag("parser");
+    assert(CharArrayAllocator::registerTag("parser") == parser);
+    assert(std::string(CharArrayAllocator::tagName(parser)) == "parser");
+    {
+        CharArrayAllocator::TagScope scope(parser);
+        CharArrayList list;
+        for (int i = 0; i < 10; i++) {
+            list.pushAtBack('a');
+        }
+        assert(list.size() == 10);
+        CharArrayAllocator::Stats tagged = CharArrayAllocator::stats(parser);
+        assert(tagged.liveBytes == 14);
+        assert(tagged.instances == 1);
+        CharArrayAllocator::Stats now = CharArrayAllocator::stats();
+        assert(now.liveBytes == before.liveBytes + 14);
+        assert(now.instances == before.instances + 1);
+        assert(CharArrayAllocator::currentTag() == parser);
+    }
+    assert(CharArrayAllocator::currentTag() == 0);
+    CharArrayAllocator::Stats tagged = CharArrayAllocator::stats(parser);
+    assert(tagged.liveBytes == 0);
+    assert(tagged.peakBytes >= 14);
+    assert(tagged.instances == 0);
+    assert(CharArrayAllocator::stats().liveBytes == before.liveBytes);
+}
+
+void accounting_Test2() {
+    // growth past the budget throws its own exception and leaves the list
+    // as it was
+    CharArrayList list;
+    for (int i = 0; i < 30; i++) {
+        list.pushAtBack('a');
+    }
+    CharArrayAllocator::setBudget(CharArrayAllocator::stats().liveBytes + 10);
+    bool thrown = false;
+    try {
+        list.pushAtBack('b');
+    } catch (const CharArrayBudgetExceeded &e) {
+        thrown = true;
+        assert(std::string(e.what()) ==
+               "cannot allocate 62 bytes within budget of " +
+               std::to_string(CharArrayAllocator::budget()) + " bytes");
+    }
+    assert(thrown);
+    assert(list.size() == 30);
+
+    // shrinking is always allowed
+    list.popFromBack();
+    list.shrink();
+    assert(list.size() == 29);
+    CharArrayAllocator::setBudget(0);
+    list.pushAtBack('b');
+    assert(list.last() == 'b');
+}
+
+void accounting_Test3() {
+    // a trim callback can make room for growth that would not fit, by
+    // freeing memory only it is using
+    CharArrayList *cache = new CharArrayList;
+    for (int i = 0; i < 1000; i++) {
+        cache->pushAtBack('a');
+    }
+
+    int id = CharArrayAllocator::addTrimCallback([&cache]() -> long {
+        long before = CharArrayAllocator::stats().liveBytes;
+        delete cache;
+        cache = nullptr;
+        return before - CharArrayAllocator::stats().liveBytes;
+    });
+    CharArrayAllocator::setBudget(CharArrayAllocator::stats().liveBytes +
+                                  100);
+    CharArrayList list;
+    for (int i = 0; i < 500; i++) {
+        list.pushAtBack('x');
+    }
+    assert(list.size() == 500);
+    assert(cache == nullptr);
+
+    CharArrayAllocator::removeTrimCallback(id);
+    CharArrayAllocator::setBudget(0);
+}
+
+void accounting_Test4() {
+    // an assignment that does not fit in the budget leaves the list as it
+    // was, and the list can still be destroyed
+    std::string big(200, 'b');
+    CharArrayList source(&big[0], big.size());
+    {
+        CharArrayList list('a');
+        list.pushAtBack('z');
+        CharArrayAllocator::setBudget(CharArrayAllocator::stats().liveBytes +
+                                      10);
+        bool thrown = false;
+        try {
+            list = source;
+        } catch (const CharArrayBudgetExceeded &) {
+            thrown = true;
+        }
+        assert(thrown);
+        CharArrayAllocator::setBudget(0);
+        assert(list.size() == 2);
+        assert(list.first() == 'a' and list.last() == 'z');
+        list = source;
+        assert(list == source);
+    }
+}
+
+void accounting_Test5() {
+    // trimAll registered as a trim callback does nothing, since shrinking
+    // would move arrays that views (here, one into spare) still point at
+    CharArrayList spare;
+    for (int i = 0; i < 1000; i++) {
+        spare.pushAtBack('s');
+    }
+    for (int i = 0; i < 990; i++) {
+        spare.popFromBack();
+    }
+    spare.setAutoTrim(0.005);
+    CharArrayListView view = spare.slice(0, 10);
+    CharArrayList list;
+    for (int i = 0; i < 1000; i++) {
+        list.pushAtBack('a' + i % 26);
+    }
+    for (int i = 0; i < 900; i++) {
+        list.popFromBack();
+    }
+    list.setAutoTrim(0.005);
+    std::string more(1000, 'm');
+    CharArrayList other(&more[0], more.size());
+    long slack = CharArrayList::trimmableSlack();
+
+    int id = CharArrayAllocator::addTrimCallback(CharArrayList::trimAll);
+    CharArrayAllocator::setBudget(CharArrayAllocator::stats().liveBytes +
+                                  1500);
+    bool exceeded = false;
+    try {
+        list.concatenate(&other);
+    } catch (const CharArrayBudgetExceeded &) {
+        exceeded = true;
+    }
+    CharArrayAllocator::removeTrimCallback(id);
+    CharArrayAllocator::setBudget(0);
+
+    assert(exceeded);
+    assert(CharArrayList::trimmableSlack() == slack);
+    assert(view.toString() == "[CharArrayList of size 10 <<ssssssssss>>]");
+    assert(list.size() == 100);
+    // at a quiet point trimAll does release the slack
+    assert(CharArrayList::trimAll() == slack);
+    list.setAutoTrim(0);
+    spare.setAutoTrim(0);
+}
+
+void accounting_Test6() {
+    // column chars and interner arena blocks are charged to the tag that
+    // was current when they were made, and are held to the budget
+    int tag = CharArrayAllocator::registerTag("columns");
+    std::string row(100, 'r');
+    CharArrayListView rowView(&row[0], row.size());
+    {
+        CharArrayAllocator::TagScope scope(tag);
+        CharArrayListColumn column;
+        CharArrayListInterner interner;
+        column.appendRow(rowView);
+        interner.intern(rowView);
+        assert(CharArrayAllocator::stats(tag).liveBytes >=
+               100 + interner.arenaBytes());
+
+        std::string big(100000, 'b');
+        CharArrayAllocator::setBudget(CharArrayAllocator::stats().liveBytes +
+                                      1000);
+        bool thrown = false;
+        try {
+            column.appendRow(CharArrayListView(&big[0], big.size()));
+        } catch (const CharArrayBudgetExceeded &) {
+            thrown = true;
+        }
+        CharArrayAllocator::setBudget(0);
+        assert(thrown);
+        assert(column.rows() == 1);
+        assert(column.view(0) == rowView);
+    }
+    assert(CharArrayAllocator::stats(tag).liveBytes == 0);
+}
+
+// TEST GROUP ArrayList
+
+void ArrayList_Test1() {
+    // trivially copyable elements
+    int arr[4] = { 1, 2, 3, 4 };
+    ArrayList<int> list(arr, 4);
+    list.insertAt(9, 2);
+    list.pushAtFront(0);
+    list.removeAt(4);
+    list.replaceAt(7, 0);
+    assert(list.size() == 5);
+    assert(list.first() == 7);
+    assert(list[2] == 2);
+    assert(list.elementAt(3) == 9);
+    assert(list.last() == 4);
+
+    // concatenating a list onto itself
+    list.concatenate(&list);
+    assert(list.size() == 10);
+    assert(list.elementAt(5) == 7);
+    assert(list.last() == 4);
+
+    ArrayList<int> copy(list);
+    list.clear();
+    assert(list.isEmpty());
+    assert(copy.size() == 10);
+    list = copy;
+    list.popFromFront();
+    list.popFromBack();
+    list.shrink();
+    assert(list.size() == 8);
+    assert(list.first() == 1);
+}
+
+void ArrayList_Test2() {
+    // elements with their own memory are moved, never copied bytewise
+    ArrayList<std::string> list;
+    for (int i = 0; i < 20; i++) {
+        list.pushAtBack(std::string(30, 'a' + i));
+    }
+    list.insertAt("front", 0);
+    list.insertAt("middle", 10);
+    list.removeAt(1);
+    assert(list.size() == 21);
+    assert(list.first() == "front");
+    assert(list.elementAt(9) == "middle");
+    assert(list.last() == std::string(30, 't'));
+
+    ArrayList<std::string> moved(std::move(list));
+    assert(list.size() == 0);
+    assert(moved.size() == 21);
+    ArrayList<std::string> copy;
+    copy = moved;
+    copy.concatenate(&moved);
+    assert(copy.size() == 42);
+    assert(copy.elementAt(30) == "middle");
+    while (not copy.isEmpty()) {
+        copy.popFromFront();
+    }
+}
+
+void ArrayList_Test3() {
+    // same error messages as CharArrayList
+    ArrayList<int> list(5);
+    std::string message;
+    try {
+        list.elementAt(1);
+    } catch (const std::range_error &e) {
+        message = e.what();
+    }
+    assert(message == "index (1) not in range [0..1)");
+    try {
+        list.insertAt(3, 2);
+    } catch (const std::range_error &e) {
+        message = e.what();
+    }
+    assert(message == "index (2) not in range [0..1]");
+    list.popFromBack();
+    try {
+        list.popFromFront();
+    } catch (const std::runtime_error &e) {
+        message = e.what();
+    }
+    assert(message == "cannot pop from empty ArrayList");
+}
+
+// TEST GROUP diff / editDistance
+
+// length of the longest common subsequence, the slow way
+static int lcsLength(const std::string &a, const std::string &b) {
+    std::vector<std::vector<int>> table(a.size() + 1,
+                                        std::vector<int>(b.size() + 1));
+    for (size_t i = 1; i <= a.size(); i++) {
+        for (size_t j = 1; j <= b.size(); j++) {
+            table[i][j] = a[i - 1] == b[j - 1]
+                              ? table[i - 1][j - 1] + 1
+                              : std::max(table[i - 1][j], table[i][j - 1]);
+        }
+    }
+    return table[a.size()][b.size()];
+}
+
+// Levenshtein distance, the slow way
+static int levenshtein(const std::string &a, const std::string &b) {
+    std::vector<std::vector<int>> table(a.size() + 1,
+                                        std::vector<int>(b.size() + 1));
+    for (size_t i = 0; i <= a.size(); i++) {
+        for (size_t j = 0; j <= b.size(); j++) {
+            if (i == 0 or j == 0) {
+                table[i][j] = i + j;
+            } else {
+                table[i][j] = std::min({ table[i - 1][j] + 1,
+                                         table[i][j - 1] + 1,
+                                         table[i - 1][j - 1] +
+                                             (a[i - 1] != b[j - 1]) });
+            }
+        }
+    }
+    return table[a.size()][b.size()];
+}
+
+void diff_Test1() {
+    std::string s = "the quick brown fox";
+    std::string t = "the quack brown fox!";
+    CharArrayList a(&s[0], s.size());
+    CharArrayList b(&t[0], t.size());
+    std::vector<CharArrayList::Edit> edits = CharArrayList::diff(a, b);
+    assert(edits.size() == 3);
+    a.applyEdits(edits.data(), edits.size());
+    assert(a == b);
+
+    CharArrayList empty;
+    assert(CharArrayList::diff(b, b).empty());
+    edits = CharArrayList::diff(empty, b);
+    assert(static_cast<int>(edits.size()) == b.size());
+    edits = CharArrayList::diff(b, empty);
+    assert(static_cast<int>(edits.size()) == b.size());
+    b.applyEdits(edits.data(), edits.size());
+    assert(b.isEmpty());
+}
+
+void diff_Test2() {
+    // on random lists over a small alphabet, the script always works and
+    // is as short as possible
+    unsigned int seed = 7;
+    auto next = [&seed]() {
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 16) & 0x7FFF;
+    };
+    for (int round = 0; round < 300; round++) {
+        std::string s, t;
+        int n = next() % 40, m = next() % 40;
+        for (int i = 0; i < n; i++) {
+            s += 'a' + next() % 3;
+        }
+        for (int i = 0; i < m; i++) {
+            t += 'a' + next() % 3;
+        }
+        CharArrayList a(&s[0], s.size());
+        CharArrayList b(&t[0], t.size());
+        std::vector<CharArrayList::Edit> edits = CharArrayList::diff(a, b);
+        assert(static_cast<int>(edits.size()) ==
+               n + m - 2 * lcsLength(s, t));
+        a.applyEdits(edits.data(), edits.size());
+        assert(a == b);
+        assert(CharArrayList::editDistance(CharArrayList(&s[0], s.size()),
+                                           b) == levenshtein(s, t));
+    }
+}
+
+void editDistance_Test1() {
+    std::string s = "kitten", t = "sitting";
+    CharArrayList a(&s[0], s.size());
+    CharArrayList b(&t[0], t.size());
+    assert(CharArrayList::editDistance(a, b) == 3);
+    assert(CharArrayList::editDistance(b, a) == 3);
+    assert(CharArrayList::editDistance(a, a) == 0);
+    assert(CharArrayList::editDistance(a, CharArrayList()) == 6);
+
+    // exactly 64 chars uses every bit, and longer lists use the table
+    for (int length : { 63, 64, 65, 200 }) {
+        std::string u, v;
+        for (int i = 0; i < length; i++) {
+            u += 'a' + i % 7;
+            v += 'a' + (i * 3) % 5;
+        }
+        v[length / 2] = 'z';
+        CharArrayList c(&u[0], u.size());
+        CharArrayList d(&v[0], v.size());
+        d.pushAtBack('q');
+        assert(CharArrayList::editDistance(c, d) == levenshtein(u, v + "q"));
+    }
+}
+
+// TEST GROUP CharArrayListStream
+
+void stream_Test1() {
+    // a file read in chunks, both ways, comes back whole and in order with
+    // a short last chunk
+    std::string text;
+    for (int i = 0; i < 1000; i++) {
+        text += 'a' + i % 26;
+    }
+    char path[] = "/tmp/CharArrayListStreamXXXXXX";
+    int fd = mkstemp(path);
+    assert(fd != -1);
+    assert(write(fd, text.data(), text.size()) == 1000);
+
+    for (int mapped = 0; mapped < 2; mapped++) {
+        assert(lseek(fd, 0, SEEK_SET) == 0);
+        CharArrayListGenerator chunks =
+            mapped ? CharArrayListStream::mapChunks(fd, 300)
+                   : CharArrayListStream::readChunks(fd, 300);
+        std::string seen;
+        std::vector<int> sizes;
+        while (chunks.next()) {
+            const CharArrayListView &chunk = chunks.value();
+            sizes.push_back(chunk.size());
+            for (int i = 0; i < chunk.size(); i++) {
+                seen += chunk.elementAt(i);
+            }
+        }
+        assert(seen == text);
+        assert((sizes == std::vector<int>{ 300, 300, 300, 100 }));
+        assert(not chunks.next());
+    }
+    close(fd);
+    unlink(path);
+}
+
+void stream_Test2() {
+    // a pipe gives full chunks even though writes arrive in small pieces,
+    // and mapChunks falls back to reading it
+    int fds[2];
+    assert(pipe(fds) == 0);
+    std::thread writer([&fds]() {
+        for (int i = 0; i < 100; i++) {
+            char piece[7] = { 'p', 'i', 'p', 'e', 'd', '-', '!' };
+            assert(write(fds[1], piece, 7) == 7);
+        }
+        close(fds[1]);
+    });
+    CharArrayList all;
+    long appended = CharArrayListStream::append(
+        CharArrayListStream::mapChunks(fds[0], 64), all);
+    writer.join();
+    close(fds[0]);
+    assert(appended == 700);
+    assert(all.size() == 700);
+    for (int i = 0; i < 700; i++) {
+        assert(all[i] == "piped-!"[i % 7]);
+    }
+}
+
+void stream_Test3() {
+    // transform then prefetch then append gives the same result as doing
+    // it all at once, and an empty output is skipped
+    CharArrayList input;
+    for (int i = 0; i < 5000; i++) {
+        input.pushAtBack(i % 3 == 0 ? 'x' : 'a' + i % 26);
+    }
+    CharArrayListStream::Transform upperNoX =
+        [](const CharArrayListView &in, CharArrayList &out) {
+            for (int i = 0; i < in.size(); i++) {
+                if (in.elementAt(i) != 'x') {
+                    out.pushAtBack(in.elementAt(i) - 'a' + 'A');
+                }
+            }
+        };
+
+    CharArrayList expected;
+    for (int i = 0; i < input.size(); i++) {
+        if (input[i] != 'x') {
+            expected.pushAtBack(input[i] - 'a' + 'A');
+        }
+    }
+
+    for (int depth : { 1, 3 }) {
+        CharArrayList result('!');
+        long appended = CharArrayListStream::append(
+            CharArrayListStream::prefetch(
+                CharArrayListStream::transform(
+                    CharArrayListStream::prefetch(
+                        CharArrayListStream::chunksOf(input, 97), depth),
+                    upperNoX),
+                depth),
+            result);
+        assert(appended == expected.size());
+        assert(result.first() == '!');
+        result.popFromFront();
+        assert(result == expected);
+    }
+
+    CharArrayList xs('x');
+    CharArrayListGenerator none = CharArrayListStream::transform(
+        CharArrayListStream::chunksOf(xs, 1), upperNoX);
+    assert(not none.next());
+}
+
+void stream_Test4() {
+    // stages reuse their buffers, so streaming a list takes far less memory
+    // than the list itself however long it is
+    CharArrayList input;
+    for (int i = 0; i < 16384; i++) {
+        input.pushAtBack('a' + i % 26);
+    }
+    long before = CharArrayAllocator::stats().liveBytes;
+    CharArrayListGenerator chunks = CharArrayListStream::prefetch(
+        CharArrayListStream::transform(
+            CharArrayListStream::chunksOf(input, 256),
+            [](const CharArrayListView &in, CharArrayList &out) {
+                for (int i = 0; i < in.size(); i++) {
+                    out.pushAtBack(in.elementAt(i));
+                }
+            }),
+        2);
+    int count = 0;
+    while (chunks.next()) {
+        assert(chunks.value().size() == 256);
+        assert(CharArrayAllocator::stats().liveBytes - before < 4096);
+        count++;
+    }
+    assert(count == 64);
+}
+
+void stream_Test5() {
+    // errors: bad sizes are caught up front, read errors come out of next(),
+    // also through prefetch, and stopping early shuts the thread down
+    bool thrown = false;
+    try {
+        CharArrayListStream::readChunks(0, 0);
+    } catch (const std::range_error &e) {
+        thrown = true;
+        assert(std::string(e.what()) == "chunk size must be positive");
+    }
+    assert(thrown);
+
+    thrown = false;
+    try {
+        CharArrayListStream::prefetch(
+            CharArrayListStream::chunksOf(CharArrayList(), 4), 0);
+    } catch (const std::range_error &e) {
+        thrown = true;
+        assert(std::string(e.what()) == "prefetch depth must be positive");
+    }
+    assert(thrown);
+
+    thrown = false;
+    CharArrayListGenerator bad = CharArrayListStream::prefetch(
+        CharArrayListStream::readChunks(-1, 16), 1);
+    try {
+        bad.next();
+    } catch (const std::runtime_error &e) {
+        thrown = true;
+        assert(std::string(e.what()).starts_with(
+            "cannot read ArrayList chunk: "));
+    }
+    assert(thrown);
+    assert(not bad.next());
+
+    CharArrayList big;
+    for (int i = 0; i < 10000; i++) {
+        big.pushAtBack('z');
+    }
+    CharArrayListGenerator early = CharArrayListStream::prefetch(
+        CharArrayListStream::chunksOf(big, 10), 4);
+    assert(early.next());
+    assert(early.value().size() == 10);
+    CharArrayListGenerator moved = std::move(early);
+    assert(not early.next());
+    assert(moved.next());
+}
+
+// TEST GROUP aligned layout
+
+void aligned_Test1() {
+    // the allocator puts arrays whose capacity is a multiple of 64 on a
+    // cache line, and pads other capacities up to one
+    assert(CharArrayAllocator::alignedCapacity(0) == 0);
+    assert(CharArrayAllocator::alignedCapacity(1) == 64);
+    assert(CharArrayAllocator::alignedCapacity(64) == 64);
+    assert(CharArrayAllocator::alignedCapacity(65) == 128);
+    for (int capacity : { 64, 192, 4096, 1 << 21 }) {
+        char *array = CharArrayAllocator::allocate(capacity);
+        assert(reinterpret_cast<uintptr_t>(array) % 64 == 0);
+        array[capacity - 1] = 'x';
+        array = CharArrayAllocator::reallocate(array, capacity,
+                                               capacity * 2, capacity);
+        assert(reinterpret_cast<uintptr_t>(array) % 64 == 0);
+        assert(array[capacity - 1] == 'x');
+        CharArrayAllocator::release(array, capacity * 2);
+    }
+}
+
+void aligned_Test2() {
+    // an aligned list only ever holds capacities padded to 64, and every
+    // way of changing it keeps the contents right
+    CharArrayList pattern('a');
+    CharArrayList replacement('A');
+    replacement.pushAtBack('A');
+    int tag = CharArrayAllocator::registerTag("aligned");
+    CharArrayAllocator::TagScope scope(tag);
+    std::string s = "Hello, World";
+    CharArrayList list(&s[0], s.size());
+    assert(not list.isAligned());
+    assert(CharArrayAllocator::stats(tag).liveBytes == 12);
+    list.setAligned(true);
+    assert(list.isAligned());
+    assert(CharArrayAllocator::stats(tag).liveBytes == 64);
+    assert(list.toString() == "[CharArrayList of size 12 <<Hello, World>>]");
+
+    for (int i = 0; i < 100; i++) {
+        list.pushAtBack('a' + i % 26);
+    }
+    assert(list.size() == 112);
+    assert(CharArrayAllocator::stats(tag).liveBytes % 64 == 0);
+    list.toUpper();
+    assert(list.elementAt(1) == 'E' and list.elementAt(111) == 'V');
+    list.toLower();
+    assert(list.elementAt(0) == 'h' and list.elementAt(12) == 'a');
+    assert(list.size() == 112);
+
+    CharArrayList::Edit edits[2] = { { CharArrayList::INSERT, '!', 0 },
+                                     { CharArrayList::REMOVE, 0, 5 } };
+    list.applyEdits(edits, 2);
+    assert(list.size() == 112);
+    assert(list.elementAt(0) == '!' and list.elementAt(6) == ' ');
+    assert(list.replaceAll(pattern, replacement) == 4);
+    assert(list.size() == 116);
+    assert(CharArrayAllocator::stats(tag).liveBytes % 64 == 0);
+
+    list.shrink();
+    assert(CharArrayAllocator::stats(tag).liveBytes == 128);
+    list.shrink();
+    assert(CharArrayAllocator::stats(tag).liveBytes == 128);
+
+    // copies into an aligned list stay aligned; a copy made from one does
+    // not; a move takes the layout along with the array
+    CharArrayList packed('z');
+    CharArrayList target;
+    target.setAligned(true);
+    target = packed;
+    assert(target.size() == 1 and target.first() == 'z');
+    CharArrayList copy(list);
+    assert(copy == list and not copy.isAligned());
+    CharArrayList moved(std::move(list));
+    assert(moved.isAligned() and moved == copy);
+    packed = std::move(moved);
+    assert(packed.isAligned() and packed == copy);
+}
+
+void aligned_Test3() {
+    // turning the layout on copies a wrapped list out of its buffer, and
+    // trimAll leaves the padding alone
+    char test_arr[3] = { 'x', 'y', 'z' };
+    CharArrayList source(test_arr, 3);
+    std::vector<char> buffer(source.serializedSize());
+    source.serialize(buffer.data(), buffer.size());
+    CharArrayList wrapped = CharArrayList::wrap(buffer.data(), buffer.size());
+    assert(wrapped.isWrapped());
+    wrapped.setAligned(true);
+    assert(not wrapped.isWrapped());
+    assert(wrapped == source);
+
+    CharArrayList list;
+    list.setAligned(true);
+    list.setAutoTrim(0.25);
+    for (int i = 0; i < 1000; i++) {
+        list.pushAtBack('q');
+    }
+    for (int i = 0; i < 900; i++) {
+        list.popFromBack();
+    }
+    assert(list.size() == 100);
+    long slack = CharArrayList::trimmableSlack();
+    assert(CharArrayList::trimAll() == slack);
+    assert(CharArrayList::trimmableSlack() == 0);
+    assert(list.size() == 100 and list.last() == 'q');
+    list.setAutoTrim(0);
+}